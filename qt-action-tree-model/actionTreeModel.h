@@ -0,0 +1,144 @@
+#ifndef ACTIONTREEMODEL_H
+#define ACTIONTREEMODEL_H
+
+#include <QAbstractItemModel>
+
+#include <memory>
+#include <vector>
+
+// A node of the context - category - action tree the hotkey and shortcut
+// editors show. The columns of a row are the typed fields of Data instead
+// of a vector of QVariants, and a node knows its row, so finding the index
+// of a parent does not search its siblings.
+template <typename Data>
+class ActionTreeItem
+{
+public:
+  explicit ActionTreeItem(Data data, ActionTreeItem* parentItem = nullptr, int row = 0)
+    : _data(std::move(data))
+    , _parentItem(parentItem)
+    , _row(row)
+  {
+  }
+
+  ActionTreeItem(const ActionTreeItem&) = delete;
+  ActionTreeItem& operator=(const ActionTreeItem&) = delete;
+
+  ActionTreeItem* appendChild(Data data)
+  {
+    _childItems.push_back(std::make_unique<ActionTreeItem>(std::move(data), this, childCount()));
+    return _childItems.back().get();
+  }
+
+  void clear()
+  {
+    _childItems.clear();
+  }
+
+  ActionTreeItem* child(int row) const
+  {
+    if (row < 0 || row >= childCount()) {
+      return nullptr;
+    }
+
+    return _childItems[row].get();
+  }
+
+  int childCount() const { return static_cast<int>(_childItems.size()); }
+  int row() const { return _row; }
+  ActionTreeItem* parentItem() const { return _parentItem; }
+
+  const Data& data() const { return _data; }
+  Data& data() { return _data; }
+
+private:
+  std::vector<std::unique_ptr<ActionTreeItem>> _childItems;
+  Data _data;
+  ActionTreeItem* _parentItem;
+  int _row;
+};
+
+// The tree half of a QAbstractItemModel over ActionTreeItem<Data>: index(),
+// parent(), rowCount() and columnCount(). Subclasses build the tree under
+// rootItem() and map the fields of Data to data(), headerData() and flags().
+//
+// Q_OBJECT does not support templates, the subclasses declare it instead.
+template <typename Data>
+class ActionTreeModel : public QAbstractItemModel
+{
+public:
+  using Item = ActionTreeItem<Data>;
+
+  explicit ActionTreeModel(int columnCount, QObject* parent = nullptr)
+    : QAbstractItemModel(parent)
+    , _rootItem(std::make_unique<Item>(Data()))
+    , _columnCount(columnCount)
+  {
+  }
+
+  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override
+  {
+    if (!hasIndex(row, column, parent)) {
+      return QModelIndex();
+    }
+
+    Item* childItem = itemFromIndex(parent)->child(row);
+    if (childItem) {
+      return createIndex(row, column, childItem);
+    }
+
+    return QModelIndex();
+  }
+
+  QModelIndex parent(const QModelIndex& index) const override
+  {
+    if (!index.isValid()) {
+      return QModelIndex();
+    }
+
+    return indexFromItem(itemFromIndex(index)->parentItem());
+  }
+
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override
+  {
+    if (parent.column() > 0) {
+      return 0;
+    }
+
+    return itemFromIndex(parent)->childCount();
+  }
+
+  int columnCount(const QModelIndex& /*parent*/ = QModelIndex()) const override
+  {
+    return _columnCount;
+  }
+
+  // The root item for an invalid index. Indexes of a proxy model have to be
+  // mapped to this model first.
+  Item* itemFromIndex(const QModelIndex& index) const
+  {
+    if (!index.isValid()) {
+      return _rootItem.get();
+    }
+
+    return static_cast<Item*>(index.internalPointer());
+  }
+
+  QModelIndex indexFromItem(Item* item, int column = 0) const
+  {
+    if (!item || item == _rootItem.get()) {
+      return QModelIndex();
+    }
+
+    return createIndex(item->row(), column, item);
+  }
+
+protected:
+  Item* rootItem() const { return _rootItem.get(); }
+
+private:
+  std::unique_ptr<Item> _rootItem;
+  int _columnCount;
+};
+
+#endif
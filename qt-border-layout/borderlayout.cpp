@@ -14,9 +14,10 @@ BorderLayout::BorderLayout(int spacing)
 
 BorderLayout::~BorderLayout()
 {
-  QLayoutItem *l;
-  while ((l = takeAt(0))) {
-    delete l;
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      delete wrapper.item;
+    }
   }
 }
 
@@ -42,13 +43,23 @@ bool BorderLayout::hasHeightForWidth() const
 
 int BorderLayout::count() const
 {
-  return items.size();
+  int count = 0;
+  for (const auto& bucket : items) {
+    count += static_cast<int>(bucket.size());
+  }
+  return count;
 }
 
 QLayoutItem* BorderLayout::itemAt(int index) const
 {
-  ItemWrapper* wrapper = items[index];
-  return wrapper ? wrapper->item : nullptr;
+  for (const auto& bucket : items) {
+    if (index >= 0 && static_cast<size_t>(index) < bucket.size()) {
+      return bucket[index].item;
+    }
+    index -= static_cast<int>(bucket.size());
+  }
+
+  return nullptr;
 }
 
 QSize BorderLayout::minimumSize() const
@@ -58,66 +69,45 @@ QSize BorderLayout::minimumSize() const
 
 void BorderLayout::setGeometry(const QRect& rect)
 {
-  ItemWrapper* center = nullptr;
-  int eastWidth = 0;
-  int westWidth = 0;
-  int northHeight = 0;
-  int southHeight = 0;
-  int centerHeight = 0;
-
   QLayout::setGeometry(rect);
 
-  for (ItemWrapper* wrapper : items) {
-    QLayoutItem *item = wrapper->item;
-    Position position = wrapper->position;
+  // Every item is placed once, from its cached size hint.
+  const int space = spacing();
 
-    if (position == North) {
-      item->setGeometry(QRect(rect.x(), northHeight, rect.width(),
-                              item->sizeHint().height()));
-
-      northHeight += item->geometry().height() + spacing();
-    } else if (position == South) {
-      item->setGeometry(QRect(item->geometry().x(),
-                              item->geometry().y(), rect.width(),
-                              item->sizeHint().height()));
-
-      southHeight += item->geometry().height() + spacing();
-
-      item->setGeometry(QRect(rect.x(),
-                        rect.y() + rect.height() - southHeight + spacing(),
-                        item->geometry().width(),
-                        item->geometry().height()));
-    } else if (position == Center) {
-      center = wrapper;
-    }
+  int northHeight = 0;
+  for (ItemWrapper& wrapper : items[North]) {
+    const int height = wrapper.sizeHint().height();
+    wrapper.item->setGeometry(QRect(rect.x(), northHeight, rect.width(), height));
+    northHeight += height + space;
   }
 
-  centerHeight = rect.height() - northHeight - southHeight;
-
-  for (ItemWrapper* wrapper : items) {
-    QLayoutItem *item = wrapper->item;
-    Position position = wrapper->position;
-
-    if (position == West) {
-      item->setGeometry(QRect(rect.x() + westWidth, northHeight,
-                              item->sizeHint().width(), centerHeight));
+  int southHeight = 0;
+  for (ItemWrapper& wrapper : items[South]) {
+    const int height = wrapper.sizeHint().height();
+    southHeight += height + space;
+    wrapper.item->setGeometry(QRect(rect.x(), rect.y() + rect.height() - southHeight + space,
+                                    rect.width(), height));
+  }
 
-      westWidth += item->geometry().width() + spacing();
-    } else if (position == East) {
-      item->setGeometry(QRect(item->geometry().x(), item->geometry().y(),
-                              item->sizeHint().width(), centerHeight));
+  const int centerHeight = rect.height() - northHeight - southHeight;
 
-      eastWidth += item->geometry().width() + spacing();
+  int westWidth = 0;
+  for (ItemWrapper& wrapper : items[West]) {
+    const int width = wrapper.sizeHint().width();
+    wrapper.item->setGeometry(QRect(rect.x() + westWidth, northHeight, width, centerHeight));
+    westWidth += width + space;
+  }
 
-      item->setGeometry(QRect(
-                        rect.x() + rect.width() - eastWidth + spacing(),
-                        northHeight, item->geometry().width(),
-                        item->geometry().height()));
-    }
+  int eastWidth = 0;
+  for (ItemWrapper& wrapper : items[East]) {
+    const int width = wrapper.sizeHint().width();
+    eastWidth += width + space;
+    wrapper.item->setGeometry(QRect(rect.x() + rect.width() - eastWidth + space, northHeight,
+                                    width, centerHeight));
   }
 
-  if (center) {
-    center->item->setGeometry(QRect(westWidth, northHeight,
+  for (ItemWrapper& wrapper : items[Center]) {
+    wrapper.item->setGeometry(QRect(westWidth, northHeight,
                                     rect.width() - eastWidth - westWidth,
                                     centerHeight));
   }
@@ -130,43 +120,86 @@ QSize BorderLayout::sizeHint() const
 
 QLayoutItem* BorderLayout::takeAt(int index)
 {
-  if (index >= 0 && index < items.size()) {
-    ItemWrapper* layoutStruct = items[index];
-    items.erase(items.begin() + index);
-    return layoutStruct->item;
+  for (auto& bucket : items) {
+    if (index >= 0 && static_cast<size_t>(index) < bucket.size()) {
+      // Removing the last item of a position, the common case, is O(1).
+      QLayoutItem *item = bucket[index].item;
+      bucket.erase(bucket.begin() + index);
+      // The cached totals still count the item.
+      invalidate();
+      return item;
+    }
+    index -= static_cast<int>(bucket.size());
   }
 
   return nullptr;
 }
 
+void BorderLayout::invalidate()
+{
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      wrapper.cachedSizeHint = QSize();
+      wrapper.cachedMinimumSize = QSize();
+    }
+  }
+  cachedSizeHint = QSize();
+  cachedMinimumSize = QSize();
+
+  QLayout::invalidate();
+}
+
 void BorderLayout::add(QLayoutItem* item, Position position)
 {
-  items.push_back(new ItemWrapper(item, position));
+  items[position].push_back(ItemWrapper(item, position));
+  invalidate();
 }
 
 QSize BorderLayout::calculateSize(SizeType sizeType) const
 {
-  QSize totalSize;
-
-  for (ItemWrapper* wrapper : items) {
-    Position position = wrapper->position;
-    QSize itemSize;
+  QSize& totalSize = sizeType == MinimumSize ? cachedMinimumSize : cachedSizeHint;
+  if (totalSize.isValid()) {
+    return totalSize;
+  }
 
-    if (sizeType == MinimumSize) {
-      itemSize = wrapper->item->minimumSize();
-    }
-    else { // (sizeType == SizeHint)
-      itemSize = wrapper->item->sizeHint();
+  totalSize = QSize(0, 0);
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      Position position = wrapper.position;
+      QSize itemSize;
+
+      if (sizeType == MinimumSize) {
+        itemSize = wrapper.minimumSize();
+      }
+      else { // (sizeType == SizeHint)
+        itemSize = wrapper.sizeHint();
+      }
+
+      if (position == North || position == South || position == Center) {
+        totalSize.rheight() += itemSize.height();
+      }
+
+      if (position == West || position == East || position == Center) {
+        totalSize.rwidth() += itemSize.width();
+      }
     }
+  }
 
-    if (position == North || position == South || position == Center) {
-      totalSize.rheight() += itemSize.height();
-    }
+  return totalSize;
+}
 
-    if (position == West || position == East || position == Center) {
-      totalSize.rwidth() += itemSize.width();
-    }
+QSize BorderLayout::ItemWrapper::sizeHint() const
+{
+  if (!cachedSizeHint.isValid()) {
+    cachedSizeHint = item->sizeHint();
   }
+  return cachedSizeHint;
+}
 
-  return totalSize;
+QSize BorderLayout::ItemWrapper::minimumSize() const
+{
+  if (!cachedMinimumSize.isValid()) {
+    cachedMinimumSize = item->minimumSize();
+  }
+  return cachedMinimumSize;
 }
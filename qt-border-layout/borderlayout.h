@@ -4,6 +4,9 @@
 #include <QLayout>
 #include <QRect>
 
+#include <array>
+#include <vector>
+
 class BorderLayout : public QLayout
 {
 public:
@@ -23,6 +26,7 @@ public:
   void setGeometry(const QRect &rect) override;
   QSize sizeHint() const override;
   QLayoutItem* takeAt(int index) override;
+  void invalidate() override;
 
   void add(QLayoutItem* item, Position position);
 
@@ -34,14 +38,26 @@ private:
       position = p;
     }
 
+    // The hints are cached until the layout is invalidated.
+    QSize sizeHint() const;
+    QSize minimumSize() const;
+
     QLayoutItem *item;
     Position position;
+    mutable QSize cachedSizeHint;
+    mutable QSize cachedMinimumSize;
   };
 
   enum SizeType { MinimumSize, SizeHint };
   QSize calculateSize(SizeType sizeType) const;
 
-  std::vector<ItemWrapper *> items;
+  static constexpr size_t PositionCount = static_cast<size_t>(Center) + 1;
+
+  // Items are bucketed by position, which is also their index order. The
+  // wrappers are stored by value, the layout owns the items they point to.
+  std::array<std::vector<ItemWrapper>, PositionCount> items;
+  mutable QSize cachedSizeHint;
+  mutable QSize cachedMinimumSize;
 };
 
 #endif
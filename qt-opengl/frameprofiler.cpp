@@ -0,0 +1,192 @@
+#include "frameprofiler.h"
+
+#include <QFile>
+#include <QOpenGLContext>
+#include <QOpenGLTimerQuery>
+#include <QPainter>
+#include <QPolygonF>
+#include <QTextStream>
+
+FrameProfiler::FrameProfiler()
+{
+  m_queryFrames.fill(-1);
+  m_timer.start();
+}
+
+FrameProfiler::~FrameProfiler() = default;
+
+void FrameProfiler::initialize()
+{
+  m_initialized = true;
+
+  // Checked up front, QOpenGLTimerQuery::create() warns when unsupported.
+  QOpenGLContext *context = QOpenGLContext::currentContext();
+  if (context->isOpenGLES()) {
+    return;
+  }
+
+  if (context->format().version() < qMakePair(3, 3) && !context->hasExtension("GL_ARB_timer_query")) {
+    return;
+  }
+
+  for (int i = 0; i < QueryCount; ++i) {
+    auto query = std::make_unique<QOpenGLTimerQuery>();
+    if (!query->create()) {
+      m_queries.clear();
+      return;
+    }
+    m_queries.push_back(std::move(query));
+  }
+}
+
+void FrameProfiler::cleanup()
+{
+  for (const std::unique_ptr<QOpenGLTimerQuery> &query : m_queries) {
+    query->destroy();
+  }
+  m_queries.clear();
+  m_queryFrames.fill(-1);
+  m_initialized = false;
+}
+
+void FrameProfiler::beginFrame()
+{
+  if (!m_initialized) {
+    initialize();
+  }
+
+  m_history[m_frameIndex % HistorySize] = Frame();
+
+  if (!m_queries.empty()) {
+    const int slot = m_frameIndex % QueryCount;
+    collectGpuResult(slot, true);
+    m_queries[slot]->begin();
+    m_queryFrames[slot] = m_frameIndex;
+  }
+
+  m_phaseStart = m_timer.nsecsElapsed();
+}
+
+void FrameProfiler::endPhase(Phase phase)
+{
+  const qint64 now = m_timer.nsecsElapsed();
+  m_history[m_frameIndex % HistorySize].cpu[phase] += now - m_phaseStart;
+  m_phaseStart = now;
+}
+
+void FrameProfiler::endFrame()
+{
+  if (!m_queries.empty()) {
+    m_queries[m_frameIndex % QueryCount]->end();
+  }
+
+  ++m_frameIndex;
+
+  for (int slot = 0; slot < static_cast<int>(m_queries.size()); ++slot) {
+    collectGpuResult(slot, false);
+  }
+}
+
+void FrameProfiler::collectGpuResult(int slot, bool wait)
+{
+  const qint64 frameIndex = m_queryFrames[slot];
+  if (frameIndex < 0) {
+    return;
+  }
+
+  QOpenGLTimerQuery *query = m_queries[slot].get();
+  if (!wait && !query->isResultAvailable()) {
+    return;
+  }
+
+  const qint64 gpu = static_cast<qint64>(query->waitForResult());
+  if (m_frameIndex - frameIndex < HistorySize) {
+    m_history[frameIndex % HistorySize].gpu = gpu;
+  }
+  m_queryFrames[slot] = -1;
+}
+
+const FrameProfiler::Frame &FrameProfiler::frame(int age) const
+{
+  return m_history[(m_frameIndex - 1 - age) % HistorySize];
+}
+
+void FrameProfiler::paint(QPainter &painter, const QRect &rect) const
+{
+  static const std::array<QColor, PhaseCount> colors = {
+    QColor(80, 160, 255),
+    QColor(255, 170, 60),
+    QColor(120, 220, 120)
+  };
+
+  // The full height covers two frames at 60 Hz.
+  const double pixelsPerMs = rect.height() / (2000.0 / 60.0);
+  const double barWidth = static_cast<double>(rect.width()) / HistorySize;
+  const double bottom = rect.bottom() + 1;
+
+  painter.save();
+  painter.fillRect(rect, QColor(0, 0, 0, 160));
+
+  qint64 cpuTotal = 0;
+  qint64 gpuTotal = 0;
+  int gpuFrames = 0;
+  QPolygonF gpuLine;
+  for (int age = 0; age < frameCount(); ++age) {
+    const Frame &f = frame(age);
+    const double x = rect.right() + 1 - (age + 1) * barWidth;
+    double y = bottom;
+    for (int phase = 0; phase < PhaseCount; ++phase) {
+      const double height = std::min(f.cpu[phase] / 1e6 * pixelsPerMs, y - rect.top());
+      painter.fillRect(QRectF(x, y - height, barWidth, height), colors[phase]);
+      y -= height;
+      cpuTotal += f.cpu[phase];
+    }
+
+    if (f.gpu >= 0) {
+      gpuLine << QPointF(x + barWidth / 2, std::max(bottom - f.gpu / 1e6 * pixelsPerMs, static_cast<double>(rect.top())));
+      gpuTotal += f.gpu;
+      ++gpuFrames;
+    }
+  }
+
+  painter.setPen(QColor(255, 80, 80));
+  painter.drawPolyline(gpuLine);
+
+  const double budget = bottom - 1000.0 / 60.0 * pixelsPerMs;
+  painter.setPen(QColor(255, 255, 255, 96));
+  painter.drawLine(QPointF(rect.left(), budget), QPointF(rect.right(), budget));
+
+  QString text = QString("cpu %1 ms").arg(frameCount() ? cpuTotal / 1e6 / frameCount() : 0.0, 0, 'f', 2);
+  if (gpuFrames) {
+    text += QString("  gpu %1 ms").arg(gpuTotal / 1e6 / gpuFrames, 0, 'f', 2);
+  }
+  painter.setPen(Qt::white);
+  painter.drawText(rect.adjusted(4, 2, -4, -2), Qt::AlignLeft | Qt::AlignTop, text);
+  painter.restore();
+}
+
+bool FrameProfiler::saveCsv(const QString &path) const
+{
+  QFile file(path);
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Text)) {
+    return false;
+  }
+
+  QTextStream out(&file);
+  out << "frame,setup_ms,stream_ms,draw_ms,cpu_ms,gpu_ms\n";
+  for (int age = frameCount() - 1; age >= 0; --age) {
+    const Frame &f = frame(age);
+    qint64 cpu = 0;
+    out << m_frameIndex - 1 - age;
+    for (const qint64 phase : f.cpu) {
+      out << ',' << phase / 1e6;
+      cpu += phase;
+    }
+    out << ',' << cpu / 1e6 << ',';
+    if (f.gpu >= 0) {
+      out << f.gpu / 1e6;
+    }
+    out << '\n';
+  }
+  return true;
+}
@@ -0,0 +1,65 @@
+#ifndef FRAMEPROFILER_H
+#define FRAMEPROFILER_H
+
+#include <QElapsedTimer>
+#include <QtGlobal>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <vector>
+
+class QOpenGLTimerQuery;
+class QPainter;
+class QRect;
+class QString;
+
+// Rolling history of per-frame CPU phase times and GPU times.
+//
+// GPU times come from QOpenGLTimerQuery where the context supports timer
+// queries. Results are collected a few frames late from a small ring of
+// queries so that reading them never stalls the pipeline.
+class FrameProfiler
+{
+public:
+  enum Phase { Setup, Stream, Draw, PhaseCount };
+
+  struct Frame
+  {
+    std::array<qint64, PhaseCount> cpu = {};
+    qint64 gpu = -1;
+  };
+
+  static constexpr int HistorySize = 240;
+  static constexpr int QueryCount = 4;
+
+  FrameProfiler();
+  ~FrameProfiler();
+
+  void cleanup();
+
+  void beginFrame();
+  void endPhase(Phase phase);
+  void endFrame();
+
+  int frameCount() const { return static_cast<int>(std::min<qint64>(m_frameIndex, HistorySize)); }
+  const Frame &frame(int age) const;
+
+  void paint(QPainter &painter, const QRect &rect) const;
+  bool saveCsv(const QString &path) const;
+
+private:
+  void initialize();
+  void collectGpuResult(int slot, bool wait);
+
+  std::array<Frame, HistorySize> m_history;
+  qint64 m_frameIndex = 0;
+  QElapsedTimer m_timer;
+  qint64 m_phaseStart = 0;
+
+  bool m_initialized = false;
+  std::vector<std::unique_ptr<QOpenGLTimerQuery>> m_queries;
+  std::array<qint64, QueryCount> m_queryFrames;
+};
+
+#endif
@@ -0,0 +1,167 @@
+#include "headless.h"
+
+#include "logorenderer.h"
+
+#include <QElapsedTimer>
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QOpenGLBuffer>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+static double Percentile(const std::vector<qint64> &sorted, double p)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1] / 1e6;
+}
+
+int RunHeadless(const HeadlessOptions &options)
+{
+  QOffscreenSurface surface;
+  surface.setFormat(QSurfaceFormat::defaultFormat());
+  surface.create();
+
+  QOpenGLContext context;
+  context.setFormat(QSurfaceFormat::defaultFormat());
+  if (!context.create() || !context.makeCurrent(&surface)) {
+    std::cerr << "Failed to create an offscreen OpenGL context" << std::endl;
+    return 1;
+  }
+
+  QOpenGLFunctions *f = context.functions();
+  std::cout << "OpenGL renderer is " << reinterpret_cast<const char *>(f->glGetString(GL_RENDERER)) << std::endl;
+
+  const int width = options.size.width();
+  const int height = options.size.height();
+  const int frameBytes = width * height * 4;
+  std::vector<qint64> frameTimes;
+  frameTimes.reserve(options.frames);
+  StreamingBuffer::Stats streamStats;
+
+  {
+    // Multisampled framebuffers cannot be read from directly, they are
+    // resolved into a single sampled one first.
+    const int samples = context.format().samples();
+    QOpenGLFramebufferObjectFormat format;
+    format.setAttachment(QOpenGLFramebufferObject::CombinedDepthStencil);
+    std::unique_ptr<QOpenGLFramebufferObject> resolveFbo;
+    if (samples > 0 && QOpenGLFramebufferObject::hasOpenGLFramebufferBlit()) {
+      format.setSamples(samples);
+      resolveFbo = std::make_unique<QOpenGLFramebufferObject>(options.size);
+    }
+    QOpenGLFramebufferObject fbo(options.size, format);
+    QOpenGLFramebufferObject &readFbo = resolveFbo ? *resolveFbo : fbo;
+
+    std::array<QOpenGLBuffer, 2> pbos = {
+      QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer),
+      QOpenGLBuffer(QOpenGLBuffer::PixelPackBuffer)
+    };
+    for (QOpenGLBuffer &pbo : pbos) {
+      pbo.create();
+      pbo.setUsagePattern(QOpenGLBuffer::StreamRead);
+      pbo.bind();
+      pbo.allocate(frameBytes);
+      pbo.release();
+    }
+
+    FrameProfiler profiler;
+    LogoRenderer renderer;
+    renderer.setAnimated(options.animated);
+    if (!options.profilePath.isEmpty()) {
+      renderer.setProfiler(&profiler);
+    }
+    renderer.initialize();
+    renderer.resize(width, height);
+
+    QImage capture;
+    auto readBack = [&](QOpenGLBuffer &pbo, bool capturing) {
+      pbo.bind();
+      const void *pixels = pbo.mapRange(0, frameBytes, QOpenGLBuffer::RangeRead);
+      if (pixels) {
+        if (capturing) {
+          // OpenGL rows start at the bottom.
+          capture = QImage(static_cast<const uchar *>(pixels), width, height, QImage::Format_RGBA8888).mirrored();
+        }
+        pbo.unmap();
+      }
+      pbo.release();
+    };
+
+    QElapsedTimer timer;
+    for (int frame = 0; frame < options.frames; ++frame) {
+      timer.start();
+
+      fbo.bind();
+      f->glViewport(0, 0, width, height);
+      renderer.render(15 * 16, ((345 + frame) % 360) * 16, 0);
+      if (resolveFbo) {
+        QOpenGLFramebufferObject::blitFramebuffer(resolveFbo.get(), &fbo);
+      }
+
+      // Queue the read of this frame and map the one queued a frame ago, so
+      // that the transfer overlaps with rendering instead of stalling it.
+      readFbo.bind();
+      pbos[frame % 2].bind();
+      f->glReadPixels(0, 0, width, height, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+      pbos[frame % 2].release();
+      if (frame > 0) {
+        readBack(pbos[(frame + 1) % 2], false);
+      }
+
+      frameTimes.push_back(timer.nsecsElapsed());
+    }
+
+    if (options.frames > 0) {
+      readBack(pbos[(options.frames - 1) % 2], !options.capturePath.isEmpty());
+    }
+
+    if (!capture.isNull() && !capture.save(options.capturePath)) {
+      std::cerr << "Failed to write " << qPrintable(options.capturePath) << std::endl;
+    }
+
+    if (!options.profilePath.isEmpty() && !profiler.saveCsv(options.profilePath)) {
+      std::cerr << "Failed to write " << qPrintable(options.profilePath) << std::endl;
+    }
+
+    streamStats = renderer.streamStats();
+    renderer.cleanup();
+    for (QOpenGLBuffer &pbo : pbos) {
+      pbo.destroy();
+    }
+    QOpenGLFramebufferObject::bindDefault();
+  }
+
+  context.doneCurrent();
+
+  if (frameTimes.empty()) {
+    return 0;
+  }
+
+  qint64 total = 0;
+  for (const qint64 frameTime : frameTimes) {
+    total += frameTime;
+  }
+  std::sort(frameTimes.begin(), frameTimes.end());
+
+  const double mean = total / 1e6 / frameTimes.size();
+  std::cout << frameTimes.size() << " frames at " << width << "x" << height << std::endl;
+  std::cout << "mean: " << mean << " ms (" << 1000.0 / mean << " fps)" << std::endl;
+  std::cout << "p50:  " << Percentile(frameTimes, 0.50) << " ms" << std::endl;
+  std::cout << "p90:  " << Percentile(frameTimes, 0.90) << " ms" << std::endl;
+  std::cout << "p99:  " << Percentile(frameTimes, 0.99) << " ms" << std::endl;
+  std::cout << "max:  " << frameTimes.back() / 1e6 << " ms" << std::endl;
+  if (options.animated) {
+    std::cout << "upload: " << streamStats.bytesPerSecond / (1024.0 * 1024.0) << " MiB/s, "
+              << streamStats.stalls << " stalls" << std::endl;
+  }
+
+  return 0;
+}
@@ -0,0 +1,21 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <QSize>
+#include <QString>
+
+struct HeadlessOptions
+{
+  int frames = 300;
+  QSize size = QSize(1920, 1080);
+  bool animated = false;
+  QString capturePath;
+  QString profilePath;
+};
+
+// Renders the logo into an offscreen framebuffer without creating a window,
+// reads every frame back through pixel buffer objects and prints frame time
+// percentiles. Returns the process exit code.
+int RunHeadless(const HeadlessOptions &options);
+
+#endif
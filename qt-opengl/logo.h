@@ -5,22 +5,31 @@
 
 #include <QVector3D>
 
-#include <vector>
+#include <memory>
 
 class Logo
 {
 public:
-  Logo();
-  const GLfloat *constData() const { return m_data.data(); }
+  enum class Execution { Automatic, Serial, Parallel };
+
+  // The number of sectors is clamped to [1, maxSectors()].
+  explicit Logo(int numSectors = 100, Execution execution = Execution::Automatic);
+  static int maxSectors();
+
+  const GLfloat *constData() const { return m_data.get(); }
   int count() const { return m_count; }
   int vertexCount() const { return m_count / 6; }
 
 private:
-  void quad(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, GLfloat x3, GLfloat y3, GLfloat x4, GLfloat y4);
-  void extrude(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
-  void add(const QVector3D &v, const QVector3D &n);
+  void generateSectors(int first, int last);
+  void sector(int i, GLfloat *p) const;
+
+  static void quad(GLfloat *&p, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, GLfloat x3, GLfloat y3, GLfloat x4, GLfloat y4);
+  static void extrude(GLfloat *&p, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2);
+  static void add(GLfloat *&p, const QVector3D &v, const QVector3D &n);
 
-  std::vector<GLfloat> m_data;
+  std::unique_ptr<GLfloat[]> m_data;
+  int m_numSectors = 0;
   int m_count = 0;
 };
 
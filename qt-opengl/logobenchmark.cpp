@@ -0,0 +1,50 @@
+#include "logo.h"
+
+#include <QElapsedTimer>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// Usage: LogoBenchmark [sectors] [runs]
+//
+// Generates the logo mesh with the given number of sectors serially and in
+// parallel and prints the best time of each.
+static qint64 Measure(int numSectors, Logo::Execution execution, int runs)
+{
+  qint64 best = -1;
+  for (int run = 0; run < runs; ++run) {
+    QElapsedTimer timer;
+    timer.start();
+    Logo logo(numSectors, execution);
+    const qint64 elapsed = timer.nsecsElapsed();
+    best = best < 0 ? elapsed : std::min(best, elapsed);
+  }
+  return best;
+}
+
+int main(int argc, char *argv[])
+{
+  const long long sectors = argc > 1 ? std::strtoll(argv[1], nullptr, 10) : 1000000;
+  const int runs = argc > 2 ? std::atoi(argv[2]) : 5;
+  if (sectors <= 0 || sectors > Logo::maxSectors()) {
+    std::cerr << "The number of sectors has to be between 1 and " << Logo::maxSectors() << "." << std::endl;
+    return 1;
+  }
+  if (runs < 1) {
+    std::cerr << "The number of runs has to be at least 1." << std::endl;
+    return 1;
+  }
+  const int numSectors = static_cast<int>(sectors);
+
+  const Logo logo(numSectors, Logo::Execution::Serial);
+  std::cout << numSectors << " sectors, " << logo.vertexCount() / 3 << " triangles" << std::endl;
+
+  const qint64 serial = Measure(numSectors, Logo::Execution::Serial, runs);
+  const qint64 parallel = Measure(numSectors, Logo::Execution::Parallel, runs);
+  std::cout << "serial:   " << serial / 1e6 << " ms" << std::endl;
+  std::cout << "parallel: " << parallel / 1e6 << " ms" << std::endl;
+  std::cout << "speedup:  " << static_cast<double>(serial) / parallel << "x" << std::endl;
+
+  return 0;
+}
@@ -1,12 +1,36 @@
 #include <QApplication>
+#include <QCommandLineParser>
 #include <QSurfaceFormat>
 
+#include "headless.h"
 #include "widget.h"
 
+#include <iostream>
+
+// Headless runs need no display but still a GL driver, e.g. Mesa llvmpipe:
+// QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 OpenGLWindow --headless
 int main(int argc, char *argv[])
 {
   QApplication app(argc, argv);
 
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  QCommandLineOption animateOption("animate", "Deform the logo every frame through a streaming vertex buffer.");
+  parser.addOption(animateOption);
+  QCommandLineOption headlessOption("headless", "Render offscreen without a window and report frame times.");
+  parser.addOption(headlessOption);
+  QCommandLineOption framesOption("frames", "Number of frames to render in headless mode.", "count", "300");
+  parser.addOption(framesOption);
+  QCommandLineOption sizeOption("size", "Framebuffer size in headless mode.", "WxH", "1920x1080");
+  parser.addOption(sizeOption);
+  QCommandLineOption captureOption("capture", "Save the last headless frame to an image file.", "file");
+  parser.addOption(captureOption);
+  QCommandLineOption profileOption("profile", "Show a frame time graph over the viewport.");
+  parser.addOption(profileOption);
+  QCommandLineOption profileCsvOption("profile-csv", "Write the recent frame time history to a CSV file on exit.", "file");
+  parser.addOption(profileCsvOption);
+  parser.process(app);
+
   QSurfaceFormat fmt;
   fmt.setDepthBufferSize(24);
   fmt.setSamples(4);
@@ -14,9 +38,36 @@ int main(int argc, char *argv[])
   fmt.setProfile(QSurfaceFormat::CoreProfile);
   QSurfaceFormat::setDefaultFormat(fmt);
 
+  if (parser.isSet(headlessOption)) {
+    HeadlessOptions options;
+    options.frames = parser.value(framesOption).toInt();
+    const QStringList size = parser.value(sizeOption).split('x');
+    if (size.size() == 2) {
+      options.size = QSize(size[0].toInt(), size[1].toInt());
+    }
+    if (options.frames <= 0 || options.size.isEmpty()) {
+      std::cerr << "Invalid --frames or --size" << std::endl;
+      return 1;
+    }
+    options.animated = parser.isSet(animateOption);
+    options.capturePath = parser.value(captureOption);
+    options.profilePath = parser.value(profileCsvOption);
+    return RunHeadless(options);
+  }
+
   Widget widget;
   // widget.setAttribute(Qt::WA_TranslucentBackground);
   widget.setAttribute(Qt::WA_NoSystemBackground, false);
+  widget.setAnimated(parser.isSet(animateOption));
+  widget.setProfiling(parser.isSet(profileOption) || parser.isSet(profileCsvOption));
+  if (parser.isSet(profileCsvOption)) {
+    QObject::connect(&app, &QCoreApplication::aboutToQuit, [&widget, &parser, &profileCsvOption] {
+      const QString profilePath = parser.value(profileCsvOption);
+      if (!widget.saveProfile(profilePath)) {
+        std::cerr << "Failed to write " << qPrintable(profilePath) << std::endl;
+      }
+    });
+  }
   widget.show();
 
   return app.exec();
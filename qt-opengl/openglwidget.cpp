@@ -1,12 +1,11 @@
 #include "openglwidget.h"
 
 #include <QMouseEvent>
-#include <QOpenGLShaderProgram>
+#include <QPainter>
 
 OpenGLWidget::OpenGLWidget(QWidget *parent)
   : QOpenGLWidget(parent)
 {
-  m_core = QSurfaceFormat::defaultFormat().profile() == QSurfaceFormat::CoreProfile;
   // --transparent causes the clear color to be transparent. Therefore, on systems that
   // support it, the widget will become transparent apart from the logo.
   QSurfaceFormat fmt = format();
@@ -70,75 +69,47 @@ void OpenGLWidget::setZRotation(int angle)
   }
 }
 
+void OpenGLWidget::setAnimated(bool animated)
+{
+  if (animated != m_renderer.isAnimated()) {
+    m_renderer.setAnimated(animated);
+    update();
+  }
+}
+
+void OpenGLWidget::setProfiling(bool profiling)
+{
+  if (profiling == isProfiling()) {
+    return;
+  }
+
+  if (profiling) {
+    m_profiler = std::make_unique<FrameProfiler>();
+  } else {
+    // The timer queries belong to the context.
+    if (m_renderer.isInitialized()) {
+      makeCurrent();
+      m_profiler->cleanup();
+      doneCurrent();
+    }
+    m_profiler.reset();
+  }
+  m_renderer.setProfiler(m_profiler.get());
+  update();
+}
+
 void OpenGLWidget::cleanup()
 {
-  if (!m_program) {
+  if (!m_renderer.isInitialized()) {
     return;
   }
 
   makeCurrent();
-  m_logoVbo.destroy();
-  delete m_program;
-  m_program = nullptr;
+  m_renderer.cleanup();
   doneCurrent();
   QObject::disconnect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &OpenGLWidget::cleanup);
 }
 
-static const char *vertexShaderSourceCore =
-  "#version 150\n"
-  "in vec4 vertex;\n"
-  "in vec3 normal;\n"
-  "out vec3 vert;\n"
-  "out vec3 vertNormal;\n"
-  "uniform mat4 projMatrix;\n"
-  "uniform mat4 mvMatrix;\n"
-  "uniform mat3 normalMatrix;\n"
-  "void main() {\n"
-  "   vert = vertex.xyz;\n"
-  "   vertNormal = normalMatrix * normal;\n"
-  "   gl_Position = projMatrix * mvMatrix * vertex;\n"
-  "}\n";
-
-static const char *fragmentShaderSourceCore =
-  "#version 150\n"
-  "in highp vec3 vert;\n"
-  "in highp vec3 vertNormal;\n"
-  "out highp vec4 fragColor;\n"
-  "uniform highp vec3 lightPos;\n"
-  "void main() {\n"
-  "   highp vec3 L = normalize(lightPos - vert);\n"
-  "   highp float NL = max(dot(normalize(vertNormal), L), 0.0);\n"
-  "   highp vec3 color = vec3(0.39, 1.0, 0.0);\n"
-  "   highp vec3 col = clamp(color * 0.2 + color * 0.8 * NL, 0.0, 1.0);\n"
-  "   fragColor = vec4(col, 1.0);\n"
-  "}\n";
-
-static const char *vertexShaderSource =
-  "attribute vec4 vertex;\n"
-  "attribute vec3 normal;\n"
-  "varying vec3 vert;\n"
-  "varying vec3 vertNormal;\n"
-  "uniform mat4 projMatrix;\n"
-  "uniform mat4 mvMatrix;\n"
-  "uniform mat3 normalMatrix;\n"
-  "void main() {\n"
-  "   vert = vertex.xyz;\n"
-  "   vertNormal = normalMatrix * normal;\n"
-  "   gl_Position = projMatrix * mvMatrix * vertex;\n"
-  "}\n";
-
-static const char *fragmentShaderSource =
-  "varying highp vec3 vert;\n"
-  "varying highp vec3 vertNormal;\n"
-  "uniform highp vec3 lightPos;\n"
-  "void main() {\n"
-  "   highp vec3 L = normalize(lightPos - vert);\n"
-  "   highp float NL = max(dot(normalize(vertNormal), L), 0.0);\n"
-  "   highp vec3 color = vec3(0.39, 1.0, 0.0);\n"
-  "   highp vec3 col = clamp(color * 0.2 + color * 0.8 * NL, 0.0, 1.0);\n"
-  "   gl_FragColor = vec4(col, 1.0);\n"
-  "}\n";
-
 void OpenGLWidget::initializeGL()
 {
   // In this example the widget's corresponding top-level window can change
@@ -150,87 +121,26 @@ void OpenGLWidget::initializeGL()
   // can recreate all resources.
   connect(context(), &QOpenGLContext::aboutToBeDestroyed, this, &OpenGLWidget::cleanup);
 
-  initializeOpenGLFunctions();
-  glClearColor(0, 0, 0, 0);
-
-  m_program = new QOpenGLShaderProgram;
-  m_program->addShaderFromSourceCode(QOpenGLShader::Vertex, m_core ? vertexShaderSourceCore : vertexShaderSource);
-  m_program->addShaderFromSourceCode(QOpenGLShader::Fragment, m_core ? fragmentShaderSourceCore : fragmentShaderSource);
-  m_program->bindAttributeLocation("vertex", 0);
-  m_program->bindAttributeLocation("normal", 1);
-  m_program->link();
-
-  m_program->bind();
-  m_projMatrixLoc = m_program->uniformLocation("projMatrix");
-  m_mvMatrixLoc = m_program->uniformLocation("mvMatrix");
-  m_normalMatrixLoc = m_program->uniformLocation("normalMatrix");
-  m_lightPosLoc = m_program->uniformLocation("lightPos");
-
-  // Create a vertex array object. In OpenGL ES 2.0 and OpenGL 2.x
-  // implementations this is optional and support may not be present
-  // at all. Nonetheless the below code works in all cases and makes
-  // sure there is a VAO when one is needed.
-  m_vao.create();
-  QOpenGLVertexArrayObject::Binder vaoBinder(&m_vao);
-
-  // Setup our vertex buffer object.
-  m_logoVbo.create();
-  m_logoVbo.bind();
-  m_logoVbo.allocate(m_logo.constData(), m_logo.count() * sizeof(GLfloat));
-
-  // Store the vertex attribute bindings for the program.
-  setupVertexAttribs();
-
-  // Our camera never changes in this example.
-  m_camera.setToIdentity();
-  m_camera.translate(0, 0, -1);
-
-  // Light position is fixed.
-  m_program->setUniformValue(m_lightPosLoc, QVector3D(0, 0, 70));
-
-  m_program->release();
-}
-
-void OpenGLWidget::setupVertexAttribs()
-{
-  m_logoVbo.bind();
-  QOpenGLFunctions *f = QOpenGLContext::currentContext()->functions();
-  f->glEnableVertexAttribArray(0);
-  f->glEnableVertexAttribArray(1);
-  f->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat),
-                           nullptr);
-  f->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat),
-                           reinterpret_cast<void *>(3 * sizeof(GLfloat)));
-  m_logoVbo.release();
+  m_renderer.initialize();
 }
 
 void OpenGLWidget::paintGL()
 {
-  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
-  glEnable(GL_DEPTH_TEST);
-  glEnable(GL_CULL_FACE);
-
-  m_world.setToIdentity();
-  m_world.rotate(180.0f - (m_xRot / 16.0f), 1, 0, 0);
-  m_world.rotate(m_yRot / 16.0f, 0, 1, 0);
-  m_world.rotate(m_zRot / 16.0f, 0, 0, 1);
+  m_renderer.render(m_xRot, m_yRot, m_zRot);
 
-  QOpenGLVertexArrayObject::Binder vaoBinder(&m_vao);
-  m_program->bind();
-  m_program->setUniformValue(m_projMatrixLoc, m_proj);
-  m_program->setUniformValue(m_mvMatrixLoc, m_camera * m_world);
-  QMatrix3x3 normalMatrix = m_world.normalMatrix();
-  m_program->setUniformValue(m_normalMatrixLoc, normalMatrix);
-
-  glDrawArrays(GL_TRIANGLES, 0, m_logo.vertexCount());
+  if (m_profiler) {
+    QPainter painter(this);
+    m_profiler->paint(painter, QRect(8, height() - 88, FrameProfiler::HistorySize, 80));
+  }
 
-  m_program->release();
+  if (m_renderer.isAnimated()) {
+    update();
+  }
 }
 
 void OpenGLWidget::resizeGL(int w, int h)
 {
-  m_proj.setToIdentity();
-  m_proj.perspective(45.0f, static_cast<GLfloat>(w) / h, 0.01f, 100.0f);
+  m_renderer.resize(w, h);
 }
 
 void OpenGLWidget::mousePressEvent(QMouseEvent* event)
@@ -1,18 +1,13 @@
 #ifndef OPENGLWIDGET_H
 #define OPENGLWIDGET_H
 
-#include "logo.h"
+#include "logorenderer.h"
 
-#include <QMatrix4x4>
-
-#include <QOpenGLBuffer>
-#include <QOpenGLFunctions>
 #include <QOpenGLWidget>
-#include <QOpenGLVertexArrayObject>
 
-class QOpenGLShaderProgram;
+#include <memory>
 
-class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions
+class OpenGLWidget : public QOpenGLWidget
 {
   Q_OBJECT
 
@@ -23,10 +18,18 @@ public:
   QSize minimumSizeHint() const override;
   QSize sizeHint() const override;
 
+  bool isAnimated() const { return m_renderer.isAnimated(); }
+  const StreamingBuffer::Stats &streamStats() const { return m_renderer.streamStats(); }
+
+  bool isProfiling() const { return m_profiler != nullptr; }
+  const FrameProfiler *profiler() const { return m_profiler.get(); }
+
 public Q_SLOTS:
   void setXRotation(int angle);
   void setYRotation(int angle);
   void setZRotation(int angle);
+  void setAnimated(bool animated);
+  void setProfiling(bool profiling);
   void cleanup();
 
 Q_SIGNALS:
@@ -42,24 +45,12 @@ protected:
   void mouseMoveEvent(QMouseEvent *event) override;
 
 private:
-  void setupVertexAttribs();
-
-  bool m_core;
   int m_xRot = 0;
   int m_yRot = 0;
   int m_zRot = 0;
   QPoint m_lastPos;
-  Logo m_logo;
-  QOpenGLVertexArrayObject m_vao;
-  QOpenGLBuffer m_logoVbo;
-  QOpenGLShaderProgram *m_program = nullptr;
-  int m_projMatrixLoc = 0;
-  int m_mvMatrixLoc = 0;
-  int m_normalMatrixLoc = 0;
-  int m_lightPosLoc = 0;
-  QMatrix4x4 m_proj;
-  QMatrix4x4 m_camera;
-  QMatrix4x4 m_world;
+  LogoRenderer m_renderer;
+  std::unique_ptr<FrameProfiler> m_profiler;
 };
 
 #endif
@@ -0,0 +1,183 @@
+#include "streamingbuffer.h"
+
+#include <QOpenGLContext>
+
+#ifndef GL_MAP_PERSISTENT_BIT
+#define GL_MAP_PERSISTENT_BIT 0x0040
+#endif
+
+#ifndef GL_MAP_COHERENT_BIT
+#define GL_MAP_COHERENT_BIT 0x0080
+#endif
+
+// glBufferStorage is GL 4.4, which QOpenGLExtraFunctions does not resolve.
+using BufferStorageProc = void(QOPENGLF_APIENTRYP)(GLenum target, GLsizeiptr size, const void *data, GLbitfield flags);
+
+StreamingBuffer::StreamingBuffer()
+  : m_buffer(QOpenGLBuffer::VertexBuffer)
+{
+}
+
+bool StreamingBuffer::create(int regionSize)
+{
+  destroy();
+  initializeOpenGLFunctions();
+
+  QOpenGLContext *context = QOpenGLContext::currentContext();
+  const QPair<int, int> version = context->format().version();
+  if (context->isOpenGLES()) {
+    m_hasSync = version >= qMakePair(3, 0);
+  } else {
+    m_hasSync = version >= qMakePair(3, 2) || context->hasExtension("GL_ARB_sync");
+  }
+
+  m_regionSize = regionSize;
+  m_region = 0;
+  m_pendingBytes = 0;
+  m_stats = Stats();
+  m_frameTimer.start();
+
+  if (!m_buffer.create()) {
+    return false;
+  }
+
+  m_buffer.bind();
+  if (!m_hasSync || !createPersistent()) {
+    m_buffer.setUsagePattern(QOpenGLBuffer::StreamDraw);
+    m_buffer.allocate(m_regionSize);
+  }
+  m_buffer.release();
+  return true;
+}
+
+bool StreamingBuffer::createPersistent()
+{
+  QOpenGLContext *context = QOpenGLContext::currentContext();
+  if (context->isOpenGLES()) {
+    return false;
+  }
+
+  if (context->format().version() < qMakePair(4, 4) && !context->hasExtension("GL_ARB_buffer_storage")) {
+    return false;
+  }
+
+  auto bufferStorage = reinterpret_cast<BufferStorageProc>(context->getProcAddress("glBufferStorage"));
+  if (!bufferStorage) {
+    return false;
+  }
+
+  const GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+  const GLsizeiptr size = static_cast<GLsizeiptr>(m_regionSize) * RegionCount;
+  bufferStorage(GL_ARRAY_BUFFER, size, nullptr, flags);
+  m_mapped = static_cast<char *>(glMapBufferRange(GL_ARRAY_BUFFER, 0, size, flags));
+  if (m_mapped) {
+    return true;
+  }
+
+  // Immutable storage cannot be reallocated for orphaning, start over with a
+  // fresh buffer object.
+  m_buffer.release();
+  m_buffer.destroy();
+  m_buffer.create();
+  m_buffer.bind();
+  return false;
+}
+
+void StreamingBuffer::destroy()
+{
+  if (!m_buffer.isCreated()) {
+    return;
+  }
+
+  for (GLsync &fence : m_fences) {
+    if (fence) {
+      glDeleteSync(fence);
+      fence = nullptr;
+    }
+  }
+
+  if (m_mapped) {
+    m_buffer.bind();
+    glUnmapBuffer(GL_ARRAY_BUFFER);
+    m_buffer.release();
+    m_mapped = nullptr;
+  }
+
+  m_buffer.destroy();
+  m_staging.clear();
+}
+
+void StreamingBuffer::waitForRegion()
+{
+  GLsync &fence = m_fences[m_region];
+  if (!fence) {
+    return;
+  }
+
+  GLenum result = glClientWaitSync(fence, 0, 0);
+  if (result == GL_TIMEOUT_EXPIRED) {
+    // The GPU is more than RegionCount frames behind.
+    ++m_stats.stalls;
+    do {
+      result = glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000);
+    } while (result == GL_TIMEOUT_EXPIRED);
+  }
+
+  glDeleteSync(fence);
+  fence = nullptr;
+}
+
+void *StreamingBuffer::map()
+{
+  if (m_mapped) {
+    waitForRegion();
+    return m_mapped + regionOffset();
+  }
+
+  // Orphan the previous storage so that the driver can hand out fresh memory
+  // instead of waiting for the GPU to finish reading the last frame.
+  m_buffer.bind();
+  m_buffer.allocate(m_regionSize);
+  m_orphanMapped = m_buffer.mapRange(0, m_regionSize, QOpenGLBuffer::RangeWrite | QOpenGLBuffer::RangeInvalidateBuffer);
+  if (m_orphanMapped) {
+    return m_orphanMapped;
+  }
+
+  m_staging.resize(m_regionSize);
+  return m_staging.data();
+}
+
+void StreamingBuffer::unmap(int bytesWritten)
+{
+  if (!m_mapped) {
+    if (m_orphanMapped) {
+      m_buffer.unmap();
+      m_orphanMapped = nullptr;
+    } else {
+      m_buffer.write(0, m_staging.data(), bytesWritten);
+    }
+    m_buffer.release();
+  }
+
+  m_pendingBytes += bytesWritten;
+}
+
+void StreamingBuffer::fence()
+{
+  if (m_mapped) {
+    m_fences[m_region] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    m_region = (m_region + 1) % RegionCount;
+  }
+
+  const qint64 elapsed = m_frameTimer.nsecsElapsed();
+  m_frameTimer.restart();
+
+  m_stats.frameBytes = m_pendingBytes;
+  m_stats.totalBytes += m_pendingBytes;
+  if (elapsed > 0) {
+    const double rate = m_pendingBytes * 1e9 / elapsed;
+    m_stats.bytesPerSecond = m_stats.frames ? 0.9 * m_stats.bytesPerSecond + 0.1 * rate : rate;
+  }
+  ++m_stats.frames;
+  m_pendingBytes = 0;
+}
@@ -0,0 +1,70 @@
+#ifndef STREAMINGBUFFER_H
+#define STREAMINGBUFFER_H
+
+#include <QElapsedTimer>
+#include <QOpenGLBuffer>
+#include <QOpenGLExtraFunctions>
+
+#include <array>
+#include <vector>
+
+// Vertex buffer for geometry that is rewritten every frame.
+//
+// Where the context supports GL_ARB_buffer_storage the buffer is split into a
+// ring of regions that stay persistently mapped. The CPU writes the region of
+// the next frame while the GPU still reads the previous ones, and every region
+// is guarded by a fence so that it is only reused once the GPU is done with it.
+// Otherwise the buffer is orphaned and written again every frame.
+//
+// Typical frame: map(), write the vertices, unmap(), draw from regionOffset()
+// and fence().
+class StreamingBuffer : protected QOpenGLExtraFunctions
+{
+public:
+  static constexpr int RegionCount = 3;
+
+  struct Stats
+  {
+    qint64 frameBytes = 0;
+    qint64 totalBytes = 0;
+    double bytesPerSecond = 0.0;
+    int frames = 0;
+    int stalls = 0;
+  };
+
+  StreamingBuffer();
+
+  bool create(int regionSize);
+  void destroy();
+  bool isCreated() const { return m_buffer.isCreated(); }
+  bool isPersistent() const { return m_mapped != nullptr; }
+
+  void *map();
+  void unmap(int bytesWritten);
+  void fence();
+
+  QOpenGLBuffer &buffer() { return m_buffer; }
+  int regionSize() const { return m_regionSize; }
+  int regionOffset() const { return isPersistent() ? m_region * m_regionSize : 0; }
+
+  const Stats &stats() const { return m_stats; }
+
+private:
+  bool createPersistent();
+  void waitForRegion();
+
+  QOpenGLBuffer m_buffer;
+  int m_regionSize = 0;
+  int m_region = 0;
+  qint64 m_pendingBytes = 0;
+  char *m_mapped = nullptr;
+  void *m_orphanMapped = nullptr;
+  std::vector<char> m_staging;
+  std::array<GLsync, RegionCount> m_fences = {};
+  bool m_hasSync = false;
+
+  Stats m_stats;
+  QElapsedTimer m_frameTimer;
+};
+
+#endif
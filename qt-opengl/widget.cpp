@@ -41,6 +41,21 @@ Widget::Widget(QWidget* parent)
   zSlider->setValue(0 * 16);
 }
 
+void Widget::setAnimated(bool animated)
+{
+  openGLWidget->setAnimated(animated);
+}
+
+void Widget::setProfiling(bool profiling)
+{
+  openGLWidget->setProfiling(profiling);
+}
+
+bool Widget::saveProfile(const QString& path) const
+{
+  return openGLWidget->profiler() && openGLWidget->profiler()->saveCsv(path);
+}
+
 QSlider* Widget::createSlider()
 {
   QSlider *slider = new QSlider(Qt::Vertical);
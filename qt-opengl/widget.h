@@ -14,6 +14,10 @@ class Widget : public QWidget
 public:
   Widget(QWidget* parent = nullptr);
 
+  void setAnimated(bool animated);
+  void setProfiling(bool profiling);
+  bool saveProfile(const QString& path) const;
+
 private:
   QSlider *createSlider();
 
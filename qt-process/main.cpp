@@ -1,20 +1,36 @@
+#include "processPool.h"
+
 #include <QCoreApplication>
-#include <QProcess>
+
+#include <iostream>
 
 int main(int argc, char *argv[])
 {
   QCoreApplication app(argc, argv);
 
-  QProcess* myProcess = new QProcess();
-  myProcess->start("echo", {"test1"});
-  myProcess->waitForFinished();
+  ProcessPool* processPool = new ProcessPool(&app);
+  QObject::connect(processPool, &ProcessPool::idle, &app, &QCoreApplication::quit);
+
+  ProcessJob job;
+  job.program = "echo";
+  job.arguments = {"test1"};
+  job.output = ProcessOutput::Buffer;
+  job.timeout = 1000;
+  job.finished = [](const ProcessResult& result) {
+    const auto [first, second] = result.output->parts();
+    std::cout << first << second;
+  };
+  processPool->submit(job);
 
-  myProcess->setStandardOutputFile("my_file_path");
-  myProcess->start("echo", {"test2"});
-  myProcess->waitForFinished();
+  job.arguments = {"test2"};
+  job.output = ProcessOutput::File;
+  job.outputFile = "my_file_path";
+  job.finished = nullptr;
+  processPool->submit(job);
 
-  myProcess->setStandardOutputFile({});
-  myProcess->start("echo", {"test3"});
+  job.arguments = {"test3"};
+  job.output = ProcessOutput::Discard;
+  processPool->submit(job);
 
   return app.exec();
 }
@@ -0,0 +1,48 @@
+#include "outputRingBuffer.h"
+
+#include <QIODevice>
+
+OutputRingBuffer::OutputRingBuffer(qint64 capacity)
+  : _storage(static_cast<size_t>(std::max<qint64>(capacity, 1)))
+{
+}
+
+qint64 OutputRingBuffer::readFrom(QIODevice* device)
+{
+  qint64 bytesRead = 0;
+  for (;;) {
+    const qint64 available = device->bytesAvailable();
+    if (available <= 0) {
+      break;
+    }
+
+    // Up to the end of the storage, the rest goes to the front next round.
+    const qint64 contiguous = std::min(available, capacity() - _head);
+    const qint64 count = device->read(_storage.data() + _head, contiguous);
+    if (count <= 0) {
+      break;
+    }
+
+    _head = (_head + count) % capacity();
+    _totalBytes += count;
+    bytesRead += count;
+  }
+  return bytesRead;
+}
+
+void OutputRingBuffer::clear()
+{
+  _head = 0;
+  _totalBytes = 0;
+}
+
+std::pair<std::string_view, std::string_view> OutputRingBuffer::parts() const
+{
+  const char* data = _storage.data();
+  if (_totalBytes < capacity()) {
+    return {std::string_view(data, static_cast<size_t>(_head)), {}};
+  }
+
+  return {std::string_view(data + _head, static_cast<size_t>(capacity() - _head)),
+          std::string_view(data, static_cast<size_t>(_head))};
+}
@@ -0,0 +1,41 @@
+#ifndef OUTPUTRINGBUFFER_H
+#define OUTPUTRINGBUFFER_H
+
+#include <QtGlobal>
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+class QIODevice;
+
+// Keeps the last capacity() bytes a process wrote. The storage is allocated
+// once and the device reads straight into it, so streaming output through it
+// neither allocates nor goes through an intermediate QByteArray.
+class OutputRingBuffer
+{
+public:
+  explicit OutputRingBuffer(qint64 capacity);
+
+  // Reads everything available on the device, overwriting the oldest bytes.
+  qint64 readFrom(QIODevice* device);
+  void clear();
+
+  qint64 capacity() const { return static_cast<qint64>(_storage.size()); }
+  qint64 size() const { return std::min(_totalBytes, capacity()); }
+  // Including the bytes that were overwritten.
+  qint64 totalBytes() const { return _totalBytes; }
+  bool isTruncated() const { return _totalBytes > capacity(); }
+
+  // The bytes held, oldest first. The second part is only used once the
+  // buffer wrapped around.
+  std::pair<std::string_view, std::string_view> parts() const;
+
+private:
+  std::vector<char> _storage;
+  qint64 _head = 0;
+  qint64 _totalBytes = 0;
+};
+
+#endif
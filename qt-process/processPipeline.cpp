@@ -0,0 +1,315 @@
+#include "processPipeline.h"
+
+#include <QFile>
+#include <QFileInfo>
+#include <QSocketNotifier>
+
+#if defined(Q_OS_LINUX) && QT_VERSION >= QT_VERSION_CHECK(6, 0, 0)
+#define PROCESSPIPELINE_SPLICE
+#include <cerrno>
+#include <csignal>
+#include <fcntl.h>
+#include <mutex>
+#include <sys/ioctl.h>
+#include <unistd.h>
+
+// Bytes moved by one splice() and splices per notification, so that a fast
+// stage does not keep the event loop from the other pumps.
+static constexpr size_t kSpliceSize = 64 * 1024;
+static constexpr int kMaxSplicesPerActivation = 16;
+#endif
+
+ProcessPipeline::ProcessPipeline(QObject* parent)
+  : QObject(parent)
+{
+}
+
+ProcessPipeline::~ProcessPipeline()
+{
+  // ~QProcess waits for a running process, which can still emit finished().
+  for (Stage& stage : _stages) {
+    stage.process->disconnect(this);
+    delete stage.process;
+  }
+
+  for (const std::unique_ptr<Pump>& pump : _pumps) {
+    closePump(pump.get());
+  }
+}
+
+void ProcessPipeline::addStage(const QString& program, const QStringList& arguments)
+{
+  PipelineStageStats stats;
+  stats.program = program;
+  _stats.push_back(stats);
+  _arguments.push_back(arguments);
+}
+
+void ProcessPipeline::setInputFile(const QString& inputFile)
+{
+  _inputFile = inputFile;
+}
+
+void ProcessPipeline::setOutputFile(const QString& outputFile)
+{
+  _outputFile = outputFile;
+}
+
+void ProcessPipeline::setTransport(PipelineTransport transport)
+{
+  _transport = transport == PipelineTransport::Spliced && isSpliceSupported()
+      ? PipelineTransport::Spliced : PipelineTransport::Direct;
+}
+
+bool ProcessPipeline::isSpliceSupported()
+{
+#ifdef PROCESSPIPELINE_SPLICE
+  return true;
+#else
+  return false;
+#endif
+}
+
+void ProcessPipeline::start()
+{
+  if (_stats.empty() || !_stages.empty()) {
+    return;
+  }
+
+  _running = true;
+  _stages.resize(_stats.size());
+  for (int index = 0; index < static_cast<int>(_stages.size()); ++index) {
+    QProcess* process = new QProcess(this);
+    process->setProgram(_stats[index].program);
+    process->setArguments(_arguments[index]);
+    process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    connect(process, &QProcess::errorOccurred, this, [this, index](QProcess::ProcessError error) {
+      if (_stats[index].error == QProcess::UnknownError) {
+        _stats[index].error = error;
+      }
+      // There is no finished() for a process that did not start.
+      if (error == QProcess::FailedToStart) {
+        completeStage(index);
+      }
+    });
+    connect(process, &QProcess::finished, this, [this, index]() {
+      completeStage(index);
+    });
+    _stages[index].process = process;
+  }
+
+  if (_transport == PipelineTransport::Spliced) {
+    startSpliced();
+  } else {
+    startDirect();
+  }
+}
+
+void ProcessPipeline::startDirect()
+{
+  for (size_t index = 0; index + 1 < _stages.size(); ++index) {
+    _stages[index].process->setStandardOutputProcess(_stages[index + 1].process);
+  }
+  _stages.front().process->setStandardInputFile(_inputFile.isEmpty() ? QProcess::nullDevice() : _inputFile);
+  _stages.back().process->setStandardOutputFile(_outputFile.isEmpty() ? QProcess::nullDevice() : _outputFile);
+
+  for (Stage& stage : _stages) {
+    stage.elapsed.start();
+    stage.process->start();
+  }
+}
+
+void ProcessPipeline::startSpliced()
+{
+#ifdef PROCESSPIPELINE_SPLICE
+  // A stage that exits early closes its pipe, which has to fail the splice
+  // into it with EPIPE instead of killing this process.
+  static std::once_flag ignoreSigpipe;
+  std::call_once(ignoreSigpipe, []() { ::signal(SIGPIPE, SIG_IGN); });
+
+  const int stageCount = static_cast<int>(_stages.size());
+  // The read end of the pipe the current stage reads from.
+  int childInput = -1;
+  for (int index = 0; index < stageCount; ++index) {
+    int output[2];
+    int input[2] = {-1, -1};
+    int sink = -1;
+    const bool lastStage = index + 1 == stageCount;
+    if (::pipe2(output, O_CLOEXEC) == 0) {
+      if (!lastStage) {
+        if (::pipe2(input, O_CLOEXEC) == 0) {
+          sink = input[1];
+        }
+      } else {
+        const QByteArray outputFile = _outputFile.isEmpty() ? QByteArray("/dev/null") : QFile::encodeName(_outputFile);
+        sink = ::open(outputFile.constData(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+      }
+      if (sink < 0) {
+        ::close(output[0]);
+        ::close(output[1]);
+      }
+    }
+
+    if (sink < 0) {
+      // Out of descriptors, the stages before see the end of output.
+      if (childInput >= 0) {
+        ::close(childInput);
+      }
+      _stats[index].error = QProcess::FailedToStart;
+      for (int stage = index; stage < stageCount; ++stage) {
+        _stages[stage].done = true;
+      }
+      break;
+    }
+
+    // Only the ends of this process, the children expect blocking pipes.
+    ::fcntl(output[0], F_SETFL, ::fcntl(output[0], F_GETFL) | O_NONBLOCK);
+    ::fcntl(sink, F_SETFL, ::fcntl(sink, F_GETFL) | O_NONBLOCK);
+    _childDescriptors.push_back(output[1]);
+    if (childInput >= 0) {
+      _childDescriptors.push_back(childInput);
+    }
+
+    // QProcess opens the null device, which the child replaces with the pipes
+    // before exec. The pipes of the other stages are closed on exec.
+    QProcess* process = _stages[index].process;
+    process->setStandardInputFile(index == 0 && !_inputFile.isEmpty() ? _inputFile : QProcess::nullDevice());
+    process->setStandardOutputFile(QProcess::nullDevice());
+    process->setChildProcessModifier([childInput, childOutput = output[1]]() {
+      if (childInput >= 0) {
+        ::dup2(childInput, STDIN_FILENO);
+      }
+      ::dup2(childOutput, STDOUT_FILENO);
+    });
+
+    std::unique_ptr<Pump> pump = std::make_unique<Pump>();
+    pump->stage = index;
+    pump->source = output[0];
+    pump->sink = sink;
+    pump->readNotifier = new QSocketNotifier(pump->source, QSocketNotifier::Read, this);
+    pump->writeNotifier = new QSocketNotifier(pump->sink, QSocketNotifier::Write, this);
+    pump->writeNotifier->setEnabled(false);
+    connect(pump->readNotifier, &QSocketNotifier::activated, this, [this, pump = pump.get()]() {
+      this->pump(pump);
+    });
+    connect(pump->writeNotifier, &QSocketNotifier::activated, this, [this, pump = pump.get()]() {
+      this->pump(pump);
+    });
+    _pumps.push_back(std::move(pump));
+
+    _stats[index].bytes = 0;
+    childInput = input[0];
+  }
+
+  for (int index = 0; index < static_cast<int>(_pumps.size()); ++index) {
+    _stages[index].elapsed.start();
+    _stages[index].process->start();
+  }
+
+  // The children have their copies, the pumps see the end of a stage's
+  // output once it exits.
+  for (int descriptor : _childDescriptors) {
+    ::close(descriptor);
+  }
+  _childDescriptors.clear();
+
+  checkFinished();
+#endif
+}
+
+void ProcessPipeline::pump(Pump* pump)
+{
+#ifdef PROCESSPIPELINE_SPLICE
+  for (int attempt = 0; attempt < kMaxSplicesPerActivation; ++attempt) {
+    const ssize_t count = ::splice(pump->source, nullptr, pump->sink, nullptr, kSpliceSize,
+                                   SPLICE_F_MOVE | SPLICE_F_NONBLOCK);
+    if (count > 0) {
+      _stats[pump->stage].bytes += count;
+      continue;
+    }
+    if (count < 0 && errno == EINTR) {
+      continue;
+    }
+    if (count < 0 && errno == EAGAIN) {
+      // Either the stage did not write more yet or the next one is behind.
+      int pending = 0;
+      const bool sinkFull = ::ioctl(pump->source, FIONREAD, &pending) == 0 && pending > 0;
+      pump->readNotifier->setEnabled(!sinkFull);
+      pump->writeNotifier->setEnabled(sinkFull);
+      return;
+    }
+
+    // The end of the output, or the next stage is gone.
+    closePump(pump);
+    checkFinished();
+    return;
+  }
+
+  pump->readNotifier->setEnabled(true);
+  pump->writeNotifier->setEnabled(false);
+#else
+  Q_UNUSED(pump);
+#endif
+}
+
+void ProcessPipeline::closePump(Pump* pump)
+{
+#ifdef PROCESSPIPELINE_SPLICE
+  if (pump->done) {
+    return;
+  }
+
+  pump->done = true;
+  // Called from their activated() signal.
+  pump->readNotifier->setEnabled(false);
+  pump->readNotifier->deleteLater();
+  pump->writeNotifier->setEnabled(false);
+  pump->writeNotifier->deleteLater();
+  ::close(pump->source);
+  // The next stage sees the end of its input.
+  ::close(pump->sink);
+#else
+  Q_UNUSED(pump);
+#endif
+}
+
+void ProcessPipeline::completeStage(int stage)
+{
+  if (_stages[stage].done) {
+    return;
+  }
+
+  _stages[stage].done = true;
+  PipelineStageStats& stats = _stats[stage];
+  stats.nanoseconds = _stages[stage].elapsed.nsecsElapsed();
+  if (stats.error != QProcess::FailedToStart) {
+    stats.exitCode = _stages[stage].process->exitCode();
+    stats.exitStatus = _stages[stage].process->exitStatus();
+  }
+  checkFinished();
+}
+
+void ProcessPipeline::checkFinished()
+{
+  if (!_running) {
+    return;
+  }
+
+  for (const Stage& stage : _stages) {
+    if (!stage.done) {
+      return;
+    }
+  }
+  for (const std::unique_ptr<Pump>& pump : _pumps) {
+    if (!pump->done) {
+      return;
+    }
+  }
+
+  if (_transport == PipelineTransport::Direct && !_outputFile.isEmpty()) {
+    _stats.back().bytes = QFileInfo(_outputFile).size();
+  }
+
+  _running = false;
+  Q_EMIT finished();
+}
@@ -0,0 +1,116 @@
+#ifndef PROCESSPIPELINE_H
+#define PROCESSPIPELINE_H
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+#include <vector>
+
+class QSocketNotifier;
+
+enum class PipelineTransport : uint8_t {
+  // QProcess::setStandardOutputProcess(), a kernel pipe connects the stages
+  // and the data never enters this process. Only the bytes of the last stage
+  // are known, from the size of the output file.
+  Direct,
+  // Every stage writes into a pipe that this process splice()s into the
+  // next stage, which moves the pages between the pipes in the kernel and
+  // counts the bytes of every stage on the way. Linux only, Direct elsewhere.
+  // The first spliced start() ignores SIGPIPE for the whole process, so that
+  // a stage that exits early fails the splice instead of killing it.
+  Spliced
+};
+
+struct PipelineStageStats
+{
+  QString program;
+  // Written to standard output, -1 when it is not known.
+  qint64 bytes = -1;
+  qint64 nanoseconds = 0;
+  int exitCode = -1;
+  QProcess::ExitStatus exitStatus = QProcess::NormalExit;
+  // UnknownError when no error occurred.
+  QProcess::ProcessError error = QProcess::UnknownError;
+
+  double bytesPerSecond() const
+  {
+    return bytes < 0 || nanoseconds <= 0 ? 0.0 : bytes / (nanoseconds / 1e9);
+  }
+};
+
+// Runs programs with the standard output of every stage connected to the
+// standard input of the next one, like a shell pipeline. The first stage
+// reads the input file and the last one writes the output file, the null
+// device when they are not set. Standard error is forwarded.
+//
+// A pipeline runs once, finished() is emitted when every stage exited.
+class ProcessPipeline : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ProcessPipeline(QObject* parent = nullptr);
+  ~ProcessPipeline() override;
+
+  void addStage(const QString& program, const QStringList& arguments = {});
+  void setInputFile(const QString& inputFile);
+  void setOutputFile(const QString& outputFile);
+
+  // Defaults to Direct.
+  void setTransport(PipelineTransport transport);
+  // Direct where splicing is not supported.
+  PipelineTransport transport() const { return _transport; }
+  static bool isSpliceSupported();
+
+  void start();
+  bool isRunning() const { return _running; }
+
+  // Of every stage, in order.
+  const std::vector<PipelineStageStats>& stats() const { return _stats; }
+
+Q_SIGNALS:
+  void finished();
+
+private:
+  struct Stage
+  {
+    QProcess* process = nullptr;
+    QElapsedTimer elapsed;
+    bool done = false;
+  };
+
+  // Moves the output of one stage into the next stage or the output file.
+  struct Pump
+  {
+    int stage = 0;
+    int source = -1;
+    int sink = -1;
+    QSocketNotifier* readNotifier = nullptr;
+    QSocketNotifier* writeNotifier = nullptr;
+    bool done = false;
+  };
+
+  void startDirect();
+  void startSpliced();
+  void pump(Pump* pump);
+  void closePump(Pump* pump);
+  void completeStage(int stage);
+  void checkFinished();
+
+  std::vector<PipelineStageStats> _stats;
+  std::vector<QStringList> _arguments;
+  std::vector<Stage> _stages;
+  std::vector<std::unique_ptr<Pump>> _pumps;
+  // Descriptors of the children, closed here once they are started.
+  std::vector<int> _childDescriptors;
+  QString _inputFile;
+  QString _outputFile;
+  PipelineTransport _transport = PipelineTransport::Direct;
+  bool _running = false;
+};
+
+#endif
@@ -0,0 +1,101 @@
+#include "processPipeline.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QFile>
+#include <QProcess>
+#include <QTemporaryDir>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+
+// Usage: ProcessPipelineBenchmark [megabytes] [stages]
+//
+// Streams the given amount of zeros from head through a chain of cat stages
+// into a file. First the output of every stage is collected in a QByteArray
+// and written into the next one, then the stages run as a pipeline with
+// each transport, and the time and bytes per second of every stage is
+// printed.
+static qint64 MeasureBuffered(qint64 bytes, int stages, const QString& outputFile)
+{
+  QElapsedTimer timer;
+  timer.start();
+
+  QProcess process;
+  process.start("head", {"-c", QString::number(bytes), "/dev/zero"});
+  process.waitForFinished(-1);
+  QByteArray data = process.readAllStandardOutput();
+  for (int stage = 1; stage < stages; ++stage) {
+    process.start("cat");
+    process.write(data);
+    process.closeWriteChannel();
+    process.waitForFinished(-1);
+    data = process.readAllStandardOutput();
+  }
+
+  QFile file(outputFile);
+  if (file.open(QIODevice::WriteOnly)) {
+    file.write(data);
+  }
+  return timer.nsecsElapsed();
+}
+
+static qint64 MeasurePipeline(qint64 bytes, int stages, const QString& outputFile, PipelineTransport transport)
+{
+  ProcessPipeline pipeline;
+  pipeline.setTransport(transport);
+  pipeline.setOutputFile(outputFile);
+  pipeline.addStage("head", {"-c", QString::number(bytes), "/dev/zero"});
+  for (int stage = 1; stage < stages; ++stage) {
+    pipeline.addStage("cat");
+  }
+
+  QEventLoop eventLoop;
+  QObject::connect(&pipeline, &ProcessPipeline::finished, &eventLoop, &QEventLoop::quit);
+
+  QElapsedTimer timer;
+  timer.start();
+  pipeline.start();
+  if (pipeline.isRunning()) {
+    eventLoop.exec();
+  }
+  const qint64 elapsed = timer.nsecsElapsed();
+
+  for (const PipelineStageStats& stats : pipeline.stats()) {
+    std::cout << "  " << stats.program.toStdString() << ": " << stats.nanoseconds / 1e6 << " ms";
+    if (stats.bytes >= 0) {
+      std::cout << ", " << stats.bytes << " bytes, " << stats.bytesPerSecond() / 1e6 << " MB/s";
+    }
+    std::cout << std::endl;
+  }
+  return elapsed;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  const qint64 bytes = (argc > 1 ? std::atoll(argv[1]) : 512) * 1024 * 1024;
+  const int stages = std::max(argc > 2 ? std::atoi(argv[2]) : 3, 1);
+
+  QTemporaryDir temporaryDir;
+  const QString outputFile = temporaryDir.filePath("output");
+
+  std::cout << bytes << " bytes through " << stages << " stages" << std::endl;
+
+  std::cout << "buffered: " << MeasureBuffered(bytes, stages, outputFile) / 1e6 << " ms" << std::endl;
+
+  std::cout << "direct:" << std::endl;
+  const qint64 direct = MeasurePipeline(bytes, stages, outputFile, PipelineTransport::Direct);
+  std::cout << "direct: " << direct / 1e6 << " ms" << std::endl;
+
+  if (ProcessPipeline::isSpliceSupported()) {
+    std::cout << "spliced:" << std::endl;
+    const qint64 spliced = MeasurePipeline(bytes, stages, outputFile, PipelineTransport::Spliced);
+    std::cout << "spliced: " << spliced / 1e6 << " ms" << std::endl;
+  }
+
+  return 0;
+}
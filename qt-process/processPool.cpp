@@ -0,0 +1,172 @@
+#include "processPool.h"
+
+#include <QThread>
+
+#include <algorithm>
+
+ProcessPool::ProcessPool(QObject* parent)
+  : QObject(parent)
+  , _maximumConcurrency(std::max(QThread::idealThreadCount(), 1))
+{
+}
+
+ProcessPool::~ProcessPool()
+{
+  // ~QProcess kills and waits for a running process, which can still emit
+  // finished() into a slot that is already gone.
+  for (const std::unique_ptr<Slot>& slot : _slots) {
+    slot->process->disconnect(this);
+    delete slot->process;
+  }
+}
+
+void ProcessPool::submit(ProcessJob job)
+{
+  _queue.push_back(std::move(job));
+  scheduleStart();
+}
+
+void ProcessPool::setMaximumConcurrency(int maximumConcurrency)
+{
+  _maximumConcurrency = std::max(maximumConcurrency, 1);
+  scheduleStart();
+}
+
+void ProcessPool::setOutputBufferSize(qint64 outputBufferSize)
+{
+  _outputBufferSize = outputBufferSize;
+}
+
+ProcessPool::Slot* ProcessPool::createSlot()
+{
+  _slots.push_back(std::make_unique<Slot>(_outputBufferSize));
+  Slot* slot = _slots.back().get();
+
+  slot->process = new QProcess(this);
+  slot->process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+  slot->timer.setSingleShot(true);
+
+  connect(&slot->timer, &QTimer::timeout, this, [slot]() {
+    slot->timedOut = true;
+    slot->process->kill();
+  });
+  // Only emitted for ProcessOutput::Buffer, the other modes redirect stdout.
+  connect(slot->process, &QProcess::readyReadStandardOutput, this, [slot]() {
+    slot->output.readFrom(slot->process);
+  });
+  connect(slot->process, &QProcess::errorOccurred, this, [this, slot](QProcess::ProcessError error) {
+    if (slot->error == QProcess::UnknownError) {
+      slot->error = error;
+    }
+    // There is no finished() for a process that did not start.
+    if (error == QProcess::FailedToStart && slot->job) {
+      complete(slot);
+    }
+  });
+  connect(slot->process, &QProcess::finished, this, [this, slot]() {
+    if (slot->job) {
+      complete(slot);
+    }
+  });
+
+  return slot;
+}
+
+// Processes are started from the event loop, not from within the finished()
+// of the process that is reused or the callback of a job.
+void ProcessPool::scheduleStart()
+{
+  if (_startPending) {
+    return;
+  }
+
+  _startPending = true;
+  QMetaObject::invokeMethod(this, &ProcessPool::startJobs, Qt::QueuedConnection);
+}
+
+void ProcessPool::startJobs()
+{
+  _startPending = false;
+  while (!_queue.empty() && _runningCount < _maximumConcurrency) {
+    Slot* freeSlot = nullptr;
+    for (const std::unique_ptr<Slot>& slot : _slots) {
+      if (!slot->job) {
+        freeSlot = slot.get();
+        break;
+      }
+    }
+    if (!freeSlot) {
+      freeSlot = createSlot();
+    }
+
+    ProcessJob job = std::move(_queue.front());
+    _queue.pop_front();
+    start(freeSlot, std::move(job));
+  }
+}
+
+void ProcessPool::start(Slot* slot, ProcessJob job)
+{
+  QProcess* process = slot->process;
+  switch (job.output) {
+    case ProcessOutput::Discard:
+      process->setStandardOutputFile(QProcess::nullDevice());
+      break;
+    case ProcessOutput::Buffer:
+      process->setStandardOutputFile(QString());
+      break;
+    case ProcessOutput::File:
+      process->setStandardOutputFile(job.outputFile);
+      break;
+  }
+
+  slot->output.clear();
+  slot->timedOut = false;
+  slot->error = QProcess::UnknownError;
+  slot->job = std::move(job);
+  ++_runningCount;
+
+  if (slot->job->timeout > 0) {
+    slot->timer.start(slot->job->timeout);
+  }
+  slot->elapsed.start();
+  process->start(slot->job->program, slot->job->arguments);
+}
+
+void ProcessPool::complete(Slot* slot)
+{
+  slot->timer.stop();
+
+  ProcessResult result;
+  result.nanoseconds = slot->elapsed.nsecsElapsed();
+  result.error = slot->error;
+  result.timedOut = slot->timedOut;
+  if (slot->error != QProcess::FailedToStart) {
+    result.exitCode = slot->process->exitCode();
+    result.exitStatus = slot->process->exitStatus();
+  }
+
+  ProcessJob job = std::move(*slot->job);
+  slot->job.reset();
+  --_runningCount;
+
+  if (job.output == ProcessOutput::Buffer) {
+    // What the process wrote after the last readyReadStandardOutput().
+    slot->output.readFrom(slot->process);
+    result.output = &slot->output;
+  }
+
+  // The slot is free, but it is only reused from the event loop, so the
+  // output stays valid during the callback.
+  if (!_queue.empty()) {
+    scheduleStart();
+  }
+
+  if (job.finished) {
+    job.finished(result);
+  }
+
+  if (_queue.empty() && _runningCount == 0) {
+    Q_EMIT idle();
+  }
+}
@@ -0,0 +1,117 @@
+#ifndef PROCESSPOOL_H
+#define PROCESSPOOL_H
+
+#include "outputRingBuffer.h"
+
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <vector>
+
+enum class ProcessOutput : uint8_t {
+  // Standard output goes to the null device.
+  Discard,
+  // Streamed into the OutputRingBuffer of the slot running the job.
+  Buffer,
+  // The child writes to the file itself, nothing passes through this process.
+  File
+};
+
+struct ProcessResult
+{
+  int exitCode = -1;
+  QProcess::ExitStatus exitStatus = QProcess::NormalExit;
+  // UnknownError when no error occurred.
+  QProcess::ProcessError error = QProcess::UnknownError;
+  bool timedOut = false;
+  qint64 nanoseconds = 0;
+  // Only set for ProcessOutput::Buffer, and only valid during the callback.
+  // The buffer is reused by the next job.
+  const OutputRingBuffer* output = nullptr;
+
+  bool succeeded() const
+  {
+    return !timedOut && error == QProcess::UnknownError
+        && exitStatus == QProcess::NormalExit && exitCode == 0;
+  }
+};
+
+struct ProcessJob
+{
+  QString program;
+  QStringList arguments;
+  ProcessOutput output = ProcessOutput::Discard;
+  // For ProcessOutput::File.
+  QString outputFile;
+  // In milliseconds, the process is killed after it. 0 for no timeout.
+  int timeout = 0;
+  // Called on the event loop of the pool.
+  std::function<void(const ProcessResult&)> finished;
+};
+
+// Runs queued jobs with at most maximumConcurrency() processes at a time,
+// without blocking. Every slot keeps its QProcess, timeout timer and output
+// buffer for the next job, so a job only costs the process start itself.
+//
+// Standard error is forwarded to the standard error of this process.
+class ProcessPool : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit ProcessPool(QObject* parent = nullptr);
+  ~ProcessPool() override;
+
+  void submit(ProcessJob job);
+
+  // Defaults to QThread::idealThreadCount().
+  void setMaximumConcurrency(int maximumConcurrency);
+  int maximumConcurrency() const { return _maximumConcurrency; }
+  // Per slot, in bytes. Set it before the first submit().
+  void setOutputBufferSize(qint64 outputBufferSize);
+  qint64 outputBufferSize() const { return _outputBufferSize; }
+
+  int pendingCount() const { return static_cast<int>(_queue.size()); }
+  int runningCount() const { return _runningCount; }
+
+Q_SIGNALS:
+  // The queue is empty and the last running job finished.
+  void idle();
+
+private:
+  struct Slot
+  {
+    explicit Slot(qint64 outputBufferSize) : output(outputBufferSize) {}
+
+    QProcess* process = nullptr;
+    QTimer timer;
+    OutputRingBuffer output;
+    QElapsedTimer elapsed;
+    std::optional<ProcessJob> job;
+    bool timedOut = false;
+    QProcess::ProcessError error = QProcess::UnknownError;
+  };
+
+  Slot* createSlot();
+  void scheduleStart();
+  void startJobs();
+  void start(Slot* slot, ProcessJob job);
+  void complete(Slot* slot);
+
+  std::vector<std::unique_ptr<Slot>> _slots;
+  std::deque<ProcessJob> _queue;
+  int _maximumConcurrency;
+  qint64 _outputBufferSize = 64 * 1024;
+  int _runningCount = 0;
+  bool _startPending = false;
+};
+
+#endif
@@ -0,0 +1,84 @@
+#include "processPool.h"
+
+#include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QProcess>
+#include <QThread>
+
+#include <cstdlib>
+#include <iostream>
+
+// Usage: ProcessPoolBenchmark [jobs] [concurrency] [program]
+//
+// Runs the given number of short lived jobs, "echo" by default, one after the
+// other with a blocking waitForFinished() and then through the pool, and
+// prints the jobs per second of each and the failed jobs of the pool runs.
+static qint64 MeasureBlocking(const QString& program, int jobs)
+{
+  QElapsedTimer timer;
+  timer.start();
+  QProcess process;
+  for (int job = 0; job < jobs; ++job) {
+    process.start(program, {QString::number(job)});
+    process.waitForFinished();
+    process.readAllStandardOutput();
+  }
+  return timer.nsecsElapsed();
+}
+
+static qint64 MeasurePool(const QString& program, int jobs, int concurrency, int& failures)
+{
+  ProcessPool processPool;
+  processPool.setMaximumConcurrency(concurrency);
+  processPool.setOutputBufferSize(4096);
+
+  QEventLoop eventLoop;
+  QObject::connect(&processPool, &ProcessPool::idle, &eventLoop, &QEventLoop::quit);
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int job = 0; job < jobs; ++job) {
+    ProcessJob processJob;
+    processJob.program = program;
+    processJob.arguments = {QString::number(job)};
+    processJob.output = ProcessOutput::Buffer;
+    processJob.timeout = 10000;
+    processJob.finished = [&failures](const ProcessResult& result) {
+      if (!result.succeeded()) {
+        ++failures;
+      }
+    };
+    processPool.submit(std::move(processJob));
+  }
+  // idle() is only emitted when a job finishes.
+  if (jobs > 0) {
+    eventLoop.exec();
+  }
+  return timer.nsecsElapsed();
+}
+
+static void Print(const char* name, int jobs, qint64 nanoseconds)
+{
+  std::cout << name << nanoseconds / 1e6 << " ms, " << jobs / (nanoseconds / 1e9) << " jobs/s" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  const int jobs = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int concurrency = argc > 2 ? std::atoi(argv[2]) : QThread::idealThreadCount();
+  const QString program = argc > 3 ? QString::fromLocal8Bit(argv[3]) : QString("echo");
+
+  std::cout << jobs << " jobs of " << program.toStdString() << ", concurrency " << concurrency << std::endl;
+
+  Print("blocking: ", jobs, MeasureBlocking(program, jobs));
+
+  int failures = 0;
+  Print("pool 1:   ", jobs, MeasurePool(program, jobs, 1, failures));
+  Print("pool N:   ", jobs, MeasurePool(program, jobs, concurrency, failures));
+  std::cout << "failures: " << failures << std::endl;
+
+  return 0;
+}
@@ -0,0 +1,82 @@
+#include "workerProtocol.h"
+
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#ifdef Q_OS_WIN
+#include <fcntl.h>
+#include <io.h>
+#endif
+
+// Usage: ProcessWorker [--once text]
+//
+// A worker for WorkerPool that answers every request with its payload in
+// upper case. With --once it handles the text of the command line instead
+// and exits, the way a tool is run per job.
+static void Process(std::vector<char>& data)
+{
+  for (char& character : data) {
+    character = static_cast<char>(std::toupper(static_cast<unsigned char>(character)));
+  }
+}
+
+static bool ReadFully(char* data, size_t size)
+{
+  return size == 0 || std::fread(data, 1, size, stdin) == size;
+}
+
+static void WriteFrame(WorkerFrameType type, const std::vector<char>& payload)
+{
+  char header[kWorkerFrameHeaderSize];
+  writeWorkerFrameHeader(header, type, static_cast<quint32>(payload.size()));
+  std::fwrite(header, 1, sizeof(header), stdout);
+  std::fwrite(payload.data(), 1, payload.size(), stdout);
+}
+
+int main(int argc, char *argv[])
+{
+  if (argc > 2 && std::strcmp(argv[1], "--once") == 0) {
+    std::vector<char> data(argv[2], argv[2] + std::strlen(argv[2]));
+    Process(data);
+    std::fwrite(data.data(), 1, data.size(), stdout);
+    return 0;
+  }
+
+#ifdef Q_OS_WIN
+  _setmode(_fileno(stdin), _O_BINARY);
+  _setmode(_fileno(stdout), _O_BINARY);
+#endif
+
+  std::vector<char> payload;
+  char header[kWorkerFrameHeaderSize];
+  while (ReadFully(header, sizeof(header))) {
+    WorkerFrameType type;
+    quint32 size;
+    if (!readWorkerFrameHeader(header, type, size)) {
+      return 1;
+    }
+
+    payload.resize(size);
+    if (!ReadFully(payload.data(), size)) {
+      return 1;
+    }
+
+    switch (type) {
+      case WorkerFrameType::Request:
+        Process(payload);
+        WriteFrame(WorkerFrameType::Response, payload);
+        break;
+      case WorkerFrameType::Ping:
+        WriteFrame(WorkerFrameType::Pong, {});
+        break;
+      case WorkerFrameType::Response:
+      case WorkerFrameType::Pong:
+        return 1;
+    }
+    std::fflush(stdout);
+  }
+
+  return 0;
+}
@@ -0,0 +1,266 @@
+#include "workerPool.h"
+
+#include "workerProtocol.h"
+
+#include <algorithm>
+
+// The delay before a worker that failed is started again doubles up to this,
+// in milliseconds, so a worker that cannot start does not spin.
+static constexpr int kMaximumRestartDelay = 5000;
+
+WorkerPool::WorkerPool(const QString& program, const QStringList& arguments, int workerCount, QObject* parent)
+  : QObject(parent)
+  , _program(program)
+  , _arguments(arguments)
+{
+  for (int index = 0; index < std::max(workerCount, 1); ++index) {
+    _workers.push_back(std::make_unique<Worker>());
+    Worker* worker = _workers.back().get();
+
+    worker->process = new QProcess(this);
+    worker->process->setProgram(_program);
+    worker->process->setArguments(_arguments);
+    worker->process->setProcessChannelMode(QProcess::ForwardedErrorChannel);
+    worker->timeoutTimer.setSingleShot(true);
+    worker->restartTimer.setSingleShot(true);
+
+    connect(worker->process, &QProcess::started, this, [this, worker]() {
+      worker->running = true;
+      dispatch();
+    });
+    connect(worker->process, &QProcess::readyReadStandardOutput, this, [this, worker]() {
+      readFrames(worker);
+    });
+    connect(worker->process, &QProcess::errorOccurred, this, [this, worker](QProcess::ProcessError error) {
+      // There is no finished() for a process that did not start.
+      if (error == QProcess::FailedToStart) {
+        restartWorker(worker, WorkerError::WorkerLost);
+      }
+    });
+    connect(worker->process, &QProcess::finished, this, [this, worker]() {
+      restartWorker(worker, WorkerError::WorkerLost);
+    });
+    connect(&worker->timeoutTimer, &QTimer::timeout, this, [this, worker]() {
+      restartWorker(worker, WorkerError::Timeout);
+    });
+    connect(&worker->restartTimer, &QTimer::timeout, this, [this, worker]() {
+      startWorker(worker);
+    });
+  }
+
+  connect(&_healthCheckTimer, &QTimer::timeout, this, &WorkerPool::checkHealth);
+}
+
+WorkerPool::~WorkerPool()
+{
+  // ~QProcess kills and waits for the worker, which can still emit
+  // finished() into a worker that is already gone.
+  for (const std::unique_ptr<Worker>& worker : _workers) {
+    worker->process->disconnect(this);
+    delete worker->process;
+  }
+}
+
+void WorkerPool::start()
+{
+  if (_started) {
+    return;
+  }
+
+  _started = true;
+  for (const std::unique_ptr<Worker>& worker : _workers) {
+    startWorker(worker.get());
+  }
+  setHealthCheckInterval(_healthCheckInterval);
+}
+
+void WorkerPool::submit(QByteArray request, std::function<void(const WorkerResult&)> finished, int timeout)
+{
+  Request& queued = _queue.emplace_back();
+  queued.payload = std::move(request);
+  queued.finished = std::move(finished);
+  queued.timeout = timeout;
+  queued.elapsed.start();
+  dispatch();
+}
+
+void WorkerPool::setMaximumInFlight(int maximumInFlight)
+{
+  _maximumInFlight = std::max(maximumInFlight, 1);
+  dispatch();
+}
+
+void WorkerPool::setHealthCheckInterval(int healthCheckInterval)
+{
+  _healthCheckInterval = healthCheckInterval;
+  if (_started && _healthCheckInterval > 0) {
+    _healthCheckTimer.start(_healthCheckInterval);
+  } else {
+    _healthCheckTimer.stop();
+  }
+}
+
+void WorkerPool::startWorker(Worker* worker)
+{
+  worker->pingPending = false;
+  worker->process->start();
+}
+
+void WorkerPool::restartWorker(Worker* worker, WorkerError error)
+{
+  worker->running = false;
+  worker->pingPending = false;
+  worker->timeoutTimer.stop();
+  std::deque<Request> lost;
+  lost.swap(worker->inFlight);
+
+  if (worker->process->state() != QProcess::NotRunning) {
+    // Comes back here from finished().
+    worker->process->kill();
+  } else if (!worker->restartTimer.isActive()) {
+    ++_restartCount;
+    worker->restartTimer.start(worker->restartDelay);
+    worker->restartDelay = std::clamp(worker->restartDelay * 2, 100, kMaximumRestartDelay);
+  }
+
+  // Only the oldest request timed out, the ones behind it are lost with it.
+  for (Request& request : lost) {
+    finishRequest(request, error, QByteArray());
+    error = WorkerError::WorkerLost;
+  }
+
+  if (!lost.empty()) {
+    dispatch();
+    checkIdle();
+  }
+}
+
+void WorkerPool::readFrames(Worker* worker)
+{
+  QProcess* process = worker->process;
+  bool completed = false;
+  while (process->bytesAvailable() >= kWorkerFrameHeaderSize) {
+    char header[kWorkerFrameHeaderSize];
+    process->peek(header, kWorkerFrameHeaderSize);
+    WorkerFrameType type;
+    quint32 size;
+    const bool valid = readWorkerFrameHeader(header, type, size)
+        && (type == WorkerFrameType::Response || type == WorkerFrameType::Pong)
+        && (type == WorkerFrameType::Pong || !worker->inFlight.empty());
+    if (!valid) {
+      restartWorker(worker, WorkerError::WorkerLost);
+      return;
+    }
+    if (process->bytesAvailable() < kWorkerFrameHeaderSize + static_cast<qint64>(size)) {
+      break;
+    }
+
+    process->read(header, kWorkerFrameHeaderSize);
+    QByteArray payload = process->read(size);
+    worker->restartDelay = 0;
+    if (type == WorkerFrameType::Pong) {
+      worker->pingPending = false;
+      continue;
+    }
+
+    Request request = std::move(worker->inFlight.front());
+    worker->inFlight.pop_front();
+    armTimeout(worker);
+    finishRequest(request, WorkerError::None, std::move(payload));
+    completed = true;
+  }
+
+  if (completed) {
+    dispatch();
+    checkIdle();
+  }
+}
+
+void WorkerPool::send(Worker* worker, Request request)
+{
+  char header[kWorkerFrameHeaderSize];
+  writeWorkerFrameHeader(header, WorkerFrameType::Request, static_cast<quint32>(request.payload.size()));
+  worker->process->write(header, kWorkerFrameHeaderSize);
+  worker->process->write(request.payload);
+
+  request.deadline = request.timeout > 0 ? QDeadlineTimer(request.timeout) : QDeadlineTimer(QDeadlineTimer::Forever);
+  worker->inFlight.push_back(std::move(request));
+  if (worker->inFlight.size() == 1) {
+    armTimeout(worker);
+  }
+}
+
+void WorkerPool::armTimeout(Worker* worker)
+{
+  if (worker->inFlight.empty() || worker->inFlight.front().deadline.isForever()) {
+    worker->timeoutTimer.stop();
+    return;
+  }
+
+  const qint64 remainingTime = worker->inFlight.front().deadline.remainingTime();
+  worker->timeoutTimer.start(static_cast<int>(std::max<qint64>(remainingTime, 0)));
+}
+
+// To the running worker with the fewest requests in flight.
+void WorkerPool::dispatch()
+{
+  while (!_queue.empty()) {
+    Worker* target = nullptr;
+    for (const std::unique_ptr<Worker>& worker : _workers) {
+      if (!worker->running || static_cast<int>(worker->inFlight.size()) >= _maximumInFlight) {
+        continue;
+      }
+      if (!target || worker->inFlight.size() < target->inFlight.size()) {
+        target = worker.get();
+      }
+    }
+    if (!target) {
+      break;
+    }
+
+    Request request = std::move(_queue.front());
+    _queue.pop_front();
+    send(target, std::move(request));
+  }
+}
+
+// Busy workers are covered by the timeouts of their requests.
+void WorkerPool::checkHealth()
+{
+  for (const std::unique_ptr<Worker>& worker : _workers) {
+    if (!worker->running) {
+      continue;
+    }
+
+    if (worker->pingPending) {
+      restartWorker(worker.get(), WorkerError::WorkerLost);
+    } else if (worker->inFlight.empty()) {
+      char header[kWorkerFrameHeaderSize];
+      writeWorkerFrameHeader(header, WorkerFrameType::Ping, 0);
+      worker->process->write(header, kWorkerFrameHeaderSize);
+      worker->pingPending = true;
+    }
+  }
+}
+
+void WorkerPool::finishRequest(Request& request, WorkerError error, QByteArray response)
+{
+  if (request.finished) {
+    request.finished({error, std::move(response), request.elapsed.nsecsElapsed()});
+  }
+}
+
+void WorkerPool::checkIdle()
+{
+  if (!_queue.empty()) {
+    return;
+  }
+
+  for (const std::unique_ptr<Worker>& worker : _workers) {
+    if (!worker->inFlight.empty()) {
+      return;
+    }
+  }
+
+  Q_EMIT idle();
+}
@@ -0,0 +1,114 @@
+#ifndef WORKERPOOL_H
+#define WORKERPOOL_H
+
+#include <QByteArray>
+#include <QDeadlineTimer>
+#include <QElapsedTimer>
+#include <QObject>
+#include <QProcess>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <deque>
+#include <functional>
+#include <memory>
+#include <vector>
+
+enum class WorkerError : uint8_t {
+  None,
+  // The request did not get a response in time, the worker is restarted.
+  Timeout,
+  // The worker exited, crashed or broke the protocol with the request in
+  // flight. Requests are not retried, they need not be idempotent.
+  WorkerLost
+};
+
+struct WorkerResult
+{
+  WorkerError error = WorkerError::None;
+  QByteArray response;
+  qint64 nanoseconds = 0;
+};
+
+// Sends requests to a few long lived worker processes instead of starting a
+// process per job, so a small job costs a round trip over a pipe instead of
+// exec and dynamic linking. See workerProtocol.h for the framing.
+//
+// A request goes to the worker with the fewest requests in flight. Workers
+// that crash or stop answering are restarted, and idle workers are pinged
+// every healthCheckInterval() to find the ones that hang.
+class WorkerPool : public QObject
+{
+  Q_OBJECT
+
+public:
+  WorkerPool(const QString& program, const QStringList& arguments, int workerCount, QObject* parent = nullptr);
+  ~WorkerPool() override;
+
+  void start();
+
+  // The callback is called on the event loop of the pool. The timeout is in
+  // milliseconds from when the request is sent, 0 for no timeout.
+  void submit(QByteArray request, std::function<void(const WorkerResult&)> finished, int timeout = 0);
+
+  // Requests that are sent to a worker before it answered the previous ones.
+  // Defaults to 1.
+  void setMaximumInFlight(int maximumInFlight);
+  // In milliseconds, a worker that does not answer a ping within the interval
+  // is restarted. Defaults to 5000, 0 disables health checks.
+  void setHealthCheckInterval(int healthCheckInterval);
+  int healthCheckInterval() const { return _healthCheckInterval; }
+
+  int workerCount() const { return static_cast<int>(_workers.size()); }
+  int pendingCount() const { return static_cast<int>(_queue.size()); }
+  int restartCount() const { return _restartCount; }
+
+Q_SIGNALS:
+  // The queue is empty and no request is in flight.
+  void idle();
+
+private:
+  struct Request
+  {
+    QByteArray payload;
+    std::function<void(const WorkerResult&)> finished;
+    int timeout = 0;
+    QDeadlineTimer deadline;
+    QElapsedTimer elapsed;
+  };
+
+  struct Worker
+  {
+    QProcess* process = nullptr;
+    std::deque<Request> inFlight;
+    // Armed for the deadline of the oldest request in flight.
+    QTimer timeoutTimer;
+    QTimer restartTimer;
+    int restartDelay = 0;
+    bool pingPending = false;
+    bool running = false;
+  };
+
+  void startWorker(Worker* worker);
+  void restartWorker(Worker* worker, WorkerError error);
+  void readFrames(Worker* worker);
+  void send(Worker* worker, Request request);
+  void armTimeout(Worker* worker);
+  void dispatch();
+  void checkHealth();
+  void finishRequest(Request& request, WorkerError error, QByteArray response);
+  void checkIdle();
+
+  QString _program;
+  QStringList _arguments;
+  std::vector<std::unique_ptr<Worker>> _workers;
+  std::deque<Request> _queue;
+  QTimer _healthCheckTimer;
+  int _maximumInFlight = 1;
+  int _healthCheckInterval = 5000;
+  int _restartCount = 0;
+  bool _started = false;
+};
+
+#endif
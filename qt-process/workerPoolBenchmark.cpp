@@ -0,0 +1,97 @@
+#include "processPool.h"
+#include "workerPool.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QThread>
+
+#include <cstdlib>
+#include <iostream>
+
+// Usage: WorkerPoolBenchmark [jobs] [workers]
+//
+// Runs the given number of small jobs of ProcessWorker, first as a process
+// per job through ProcessPool and then as requests to warm workers through
+// WorkerPool, and prints the jobs per second and failed jobs of each.
+static qint64 MeasureProcessPerJob(const QString& program, int jobs, int workers, int& failures)
+{
+  ProcessPool processPool;
+  processPool.setMaximumConcurrency(workers);
+
+  QEventLoop eventLoop;
+  QObject::connect(&processPool, &ProcessPool::idle, &eventLoop, &QEventLoop::quit);
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int job = 0; job < jobs; ++job) {
+    ProcessJob processJob;
+    processJob.program = program;
+    processJob.arguments = {"--once", "job" + QString::number(job)};
+    processJob.output = ProcessOutput::Buffer;
+    processJob.timeout = 10000;
+    processJob.finished = [&failures](const ProcessResult& result) {
+      if (!result.succeeded()) {
+        ++failures;
+      }
+    };
+    processPool.submit(std::move(processJob));
+  }
+  // idle() is only emitted when a job finishes.
+  if (jobs > 0) {
+    eventLoop.exec();
+  }
+  return timer.nsecsElapsed();
+}
+
+static qint64 MeasureWarmWorkers(const QString& program, int jobs, int workers, int& failures)
+{
+  WorkerPool workerPool(program, {}, workers);
+  workerPool.start();
+
+  QEventLoop eventLoop;
+  QObject::connect(&workerPool, &WorkerPool::idle, &eventLoop, &QEventLoop::quit);
+
+  QElapsedTimer timer;
+  timer.start();
+  for (int job = 0; job < jobs; ++job) {
+    workerPool.submit("job" + QByteArray::number(job), [&failures](const WorkerResult& result) {
+      if (result.error != WorkerError::None) {
+        ++failures;
+      }
+    }, 10000);
+  }
+  // idle() is only emitted when a job finishes.
+  if (jobs > 0) {
+    eventLoop.exec();
+  }
+  return timer.nsecsElapsed();
+}
+
+static void Print(const char* name, int jobs, qint64 nanoseconds, int failures)
+{
+  std::cout << name << nanoseconds / 1e6 << " ms, " << jobs / (nanoseconds / 1e9) << " jobs/s, "
+            << nanoseconds / 1e3 / jobs << " us/job, " << failures << " failures" << std::endl;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  const int jobs = argc > 1 ? std::atoi(argv[1]) : 10000;
+  const int workers = argc > 2 ? std::atoi(argv[2]) : QThread::idealThreadCount();
+  const QString program = QDir(QCoreApplication::applicationDirPath()).filePath("ProcessWorker");
+
+  std::cout << jobs << " jobs, " << workers << " workers" << std::endl;
+
+  int failures = 0;
+  const qint64 processPerJob = MeasureProcessPerJob(program, jobs, workers, failures);
+  Print("process per job: ", jobs, processPerJob, failures);
+
+  failures = 0;
+  const qint64 warmWorkers = MeasureWarmWorkers(program, jobs, workers, failures);
+  Print("warm workers:    ", jobs, warmWorkers, failures);
+
+  return 0;
+}
@@ -0,0 +1,34 @@
+#ifndef WORKERPROTOCOL_H
+#define WORKERPROTOCOL_H
+
+#include <QtEndian>
+
+// The frames WorkerPool and its worker processes exchange over the standard
+// input and output of the worker. Every frame is its type, the big endian
+// size of the payload and the payload. A worker answers every Request with a
+// Response and every Ping with a Pong, in order.
+enum class WorkerFrameType : quint8 {
+  Request,
+  Response,
+  Ping,
+  Pong
+};
+
+static constexpr int kWorkerFrameHeaderSize = 5;
+// Larger sizes are taken for a broken stream.
+static constexpr quint32 kWorkerFrameMaximumSize = 64 * 1024 * 1024;
+
+inline void writeWorkerFrameHeader(char* header, WorkerFrameType type, quint32 size)
+{
+  header[0] = static_cast<char>(type);
+  qToBigEndian(size, header + 1);
+}
+
+inline bool readWorkerFrameHeader(const char* header, WorkerFrameType& type, quint32& size)
+{
+  type = static_cast<WorkerFrameType>(header[0]);
+  size = qFromBigEndian<quint32>(header + 1);
+  return type <= WorkerFrameType::Pong && size <= kWorkerFrameMaximumSize;
+}
+
+#endif
@@ -27,6 +27,7 @@ static const char kIdDelimiter = '.';
 
 std::vector<QAction*> _actions;
 std::unordered_map<std::string, QAction*> _idActionHash;
+std::unordered_map<std::string, int> _contextIndexHash;
 
 std::vector<QAction*> ActionManager::registeredActions()
 {
@@ -38,6 +39,8 @@ void ActionManager::registerAction(QAction* action)
   action->setProperty(kDefaultShortcutPropertyName, QVariant::fromValue(action->shortcut()));
   _actions.push_back(action);
   _idActionHash.insert({getId(action), action});
+
+  _contextIndexHash.insert({getContext(action), getContextCount()});
 }
 
 // TODO: Remove?
@@ -129,6 +132,17 @@ std::string ActionManager::getContext(QAction* action)
   return ((static_cast<size_t>(sections.size()) <= index) ? std::string() : sections[index].toStdString());
 }
 
+int ActionManager::getContextIndex(const std::string& context)
+{
+  auto it = _contextIndexHash.find(context);
+  return it != _contextIndexHash.end() ? it->second : -1;
+}
+
+int ActionManager::getContextCount()
+{
+  return static_cast<int>(_contextIndexHash.size());
+}
+
 std::string ActionManager::getCategory(QAction* action)
 {
   return action->property(kIdPropertyName).toString().split(kIdDelimiter)[static_cast<int>(Id::Category)].toStdString();
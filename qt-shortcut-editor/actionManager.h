@@ -31,6 +31,10 @@ public:
   static QAction* getAction(const std::string& id);
   static std::string getId(QAction* action);
   static std::string getContext(QAction* action);
+  // Contexts are numbered from 0 in the order they are first registered, -1
+  // for an unknown context.
+  static int getContextIndex(const std::string& context);
+  static int getContextCount();
   static std::string getCategory(QAction* action);
   static QKeySequence getDefaultShortcut(QAction* action);
   static QList<QKeySequence> getDefaultShortcuts(QAction* action);
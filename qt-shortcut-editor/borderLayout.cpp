@@ -14,9 +14,10 @@ BorderLayout::BorderLayout(int spacing)
 
 BorderLayout::~BorderLayout()
 {
-  QLayoutItem* l;
-  while ((l = takeAt(0))) {
-    delete l;
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      delete wrapper.item;
+    }
   }
 }
 
@@ -42,17 +43,23 @@ bool BorderLayout::hasHeightForWidth() const
 
 int BorderLayout::count() const
 {
-  return items.size();
+  int count = 0;
+  for (const auto& bucket : items) {
+    count += static_cast<int>(bucket.size());
+  }
+  return count;
 }
 
 QLayoutItem* BorderLayout::itemAt(int index) const
 {
-  if (static_cast<size_t>(index) >= items.size()) {
-    return nullptr;
+  for (const auto& bucket : items) {
+    if (index >= 0 && static_cast<size_t>(index) < bucket.size()) {
+      return bucket[index].item;
+    }
+    index -= static_cast<int>(bucket.size());
   }
 
-  ItemWrapper wrapper = items[index];
-  return wrapper.item;
+  return nullptr;
 }
 
 QSize BorderLayout::minimumSize() const
@@ -62,68 +69,59 @@ QSize BorderLayout::minimumSize() const
 
 void BorderLayout::setGeometry(const QRect& rect)
 {
-  ItemWrapper center;
-  int eastWidth = 0;
-  int westWidth = 0;
-  int northHeight = 0;
-  int southHeight = 0;
-  int centerHeight = 0;
-
   QLayout::setGeometry(rect);
 
-  for (ItemWrapper wrapper : items) {
-    QLayoutItem* item = wrapper.item;
-    Position position = wrapper.position;
-
-    if (position == Position::North) {
-      item->setGeometry(QRect(rect.x(), northHeight, rect.width(),
-                              item->sizeHint().height()));
+  if (laidOut) {
+    scheduler.schedule();
+  }
+  else {
+    layoutItems(rect);
+  }
+}
 
-      northHeight += item->geometry().height() + spacing();
-    } else if (position == Position::South) {
-      item->setGeometry(QRect(item->geometry().x(),
-                              item->geometry().y(), rect.width(),
-                              item->sizeHint().height()));
+void BorderLayout::layoutItems(const QRect& rect)
+{
+  laidOut = true;
 
-      southHeight += item->geometry().height() + spacing();
+  // Every item is placed once, from its cached size hint.
+  const int space = spacing();
 
-      item->setGeometry(QRect(rect.x(),
-                        rect.y() + rect.height() - southHeight + spacing(),
-                        item->geometry().width(),
-                        item->geometry().height()));
-    } else if (position == Position::Center) {
-      center = wrapper;
-    }
+  int northHeight = 0;
+  for (ItemWrapper& wrapper : itemsAt(Position::North)) {
+    const int height = wrapper.sizeHint().height();
+    LayoutScheduler::setGeometry(wrapper.item, QRect(rect.x(), northHeight, rect.width(), height));
+    northHeight += height + space;
   }
 
-  centerHeight = rect.height() - northHeight - southHeight;
-
-  for (ItemWrapper wrapper : items) {
-    QLayoutItem* item = wrapper.item;
-    Position position = wrapper.position;
-
-    if (position == Position::West) {
-      item->setGeometry(QRect(rect.x() + westWidth, northHeight,
-                              item->sizeHint().width(), centerHeight));
+  int southHeight = 0;
+  for (ItemWrapper& wrapper : itemsAt(Position::South)) {
+    const int height = wrapper.sizeHint().height();
+    southHeight += height + space;
+    LayoutScheduler::setGeometry(wrapper.item, QRect(rect.x(), rect.y() + rect.height() - southHeight + space,
+                                                     rect.width(), height));
+  }
 
-      westWidth += item->geometry().width() + spacing();
-    } else if (position == Position::East) {
-      item->setGeometry(QRect(item->geometry().x(), item->geometry().y(),
-                              item->sizeHint().width(), centerHeight));
+  const int centerHeight = rect.height() - northHeight - southHeight;
 
-      eastWidth += item->geometry().width() + spacing();
+  int westWidth = 0;
+  for (ItemWrapper& wrapper : itemsAt(Position::West)) {
+    const int width = wrapper.sizeHint().width();
+    LayoutScheduler::setGeometry(wrapper.item, QRect(rect.x() + westWidth, northHeight, width, centerHeight));
+    westWidth += width + space;
+  }
 
-      item->setGeometry(QRect(
-                        rect.x() + rect.width() - eastWidth + spacing(),
-                        northHeight, item->geometry().width(),
-                        item->geometry().height()));
-    }
+  int eastWidth = 0;
+  for (ItemWrapper& wrapper : itemsAt(Position::East)) {
+    const int width = wrapper.sizeHint().width();
+    eastWidth += width + space;
+    LayoutScheduler::setGeometry(wrapper.item, QRect(rect.x() + rect.width() - eastWidth + space, northHeight,
+                                                     width, centerHeight));
   }
 
-  if (center.item) {
-    center.item->setGeometry(QRect(westWidth, northHeight,
-                                    rect.width() - eastWidth - westWidth,
-                                    centerHeight));
+  for (ItemWrapper& wrapper : itemsAt(Position::Center)) {
+    LayoutScheduler::setGeometry(wrapper.item, QRect(westWidth, northHeight,
+                                                     rect.width() - eastWidth - westWidth,
+                                                     centerHeight));
   }
 }
 
@@ -134,43 +132,87 @@ QSize BorderLayout::sizeHint() const
 
 QLayoutItem* BorderLayout::takeAt(int index)
 {
-  if (index >= 0 && static_cast<size_t>(index) < items.size()) {
-    ItemWrapper layoutStruct = items[index];
-    items.erase(items.begin() + index);
-    return layoutStruct.item;
+  for (auto& bucket : items) {
+    if (index >= 0 && static_cast<size_t>(index) < bucket.size()) {
+      // Removing the last item of a position, the common case, is O(1).
+      QLayoutItem* item = bucket[index].item;
+      bucket.erase(bucket.begin() + index);
+      // The cached totals still count the item.
+      invalidate();
+      return item;
+    }
+    index -= static_cast<int>(bucket.size());
   }
 
   return nullptr;
 }
 
+void BorderLayout::invalidate()
+{
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      wrapper.cachedSizeHint = QSize();
+      wrapper.cachedMinimumSize = QSize();
+    }
+  }
+  cachedSizeHint = QSize();
+  cachedMinimumSize = QSize();
+  laidOut = false;
+
+  QLayout::invalidate();
+}
+
 void BorderLayout::add(QLayoutItem* item, Position position)
 {
-  items.push_back(ItemWrapper(item, position));
+  itemsAt(position).push_back(ItemWrapper(item, position));
+  invalidate();
 }
 
 QSize BorderLayout::calculateSize(SizeType sizeType) const
 {
-  QSize totalSize;
-
-  for (ItemWrapper wrapper : items) {
-    Position position = wrapper.position;
-    QSize itemSize;
+  QSize& totalSize = sizeType == MinimumSize ? cachedMinimumSize : cachedSizeHint;
+  if (totalSize.isValid()) {
+    return totalSize;
+  }
 
-    if (sizeType == MinimumSize) {
-      itemSize = wrapper.item->minimumSize();
-    }
-    else { // (sizeType == SizeHint)
-      itemSize = wrapper.item->sizeHint();
+  totalSize = QSize(0, 0);
+  for (const auto& bucket : items) {
+    for (const ItemWrapper& wrapper : bucket) {
+      Position position = wrapper.position;
+      QSize itemSize;
+
+      if (sizeType == MinimumSize) {
+        itemSize = wrapper.minimumSize();
+      }
+      else { // (sizeType == SizeHint)
+        itemSize = wrapper.sizeHint();
+      }
+
+      if (position == Position::North || position == Position::South || position == Position::Center) {
+        totalSize.rheight() += itemSize.height();
+      }
+
+      if (position == Position::West || position == Position::East || position == Position::Center) {
+        totalSize.rwidth() += itemSize.width();
+      }
     }
+  }
 
-    if (position == Position::North || position == Position::South || position == Position::Center) {
-      totalSize.rheight() += itemSize.height();
-    }
+  return totalSize;
+}
 
-    if (position == Position::West || position == Position::East || position == Position::Center) {
-      totalSize.rwidth() += itemSize.width();
-    }
+QSize BorderLayout::ItemWrapper::sizeHint() const
+{
+  if (!cachedSizeHint.isValid()) {
+    cachedSizeHint = item->sizeHint();
   }
+  return cachedSizeHint;
+}
 
-  return totalSize;
+QSize BorderLayout::ItemWrapper::minimumSize() const
+{
+  if (!cachedMinimumSize.isValid()) {
+    cachedMinimumSize = item->minimumSize();
+  }
+  return cachedMinimumSize;
 }
@@ -1,9 +1,14 @@
 #ifndef BORDERLAYOUT_H
 #define BORDERLAYOUT_H
 
+#include "layoutScheduler.h"
+
 #include <QLayout>
 #include <QRect>
 
+#include <array>
+#include <vector>
+
 class BorderLayout : public QLayout
 {
 public:
@@ -29,6 +34,7 @@ public:
   void setGeometry(const QRect& rect) override;
   QSize sizeHint() const override;
   QLayoutItem* takeAt(int index) override;
+  void invalidate() override;
 
   void add(QLayoutItem* item, Position position);
 
@@ -40,14 +46,33 @@ private:
       position = p;
     }
 
+    // The hints are cached until the layout is invalidated.
+    QSize sizeHint() const;
+    QSize minimumSize() const;
+
     QLayoutItem* item;
     Position position;
+    mutable QSize cachedSizeHint;
+    mutable QSize cachedMinimumSize;
   };
 
   enum SizeType { MinimumSize, SizeHint };
   QSize calculateSize(SizeType sizeType) const;
+  void layoutItems(const QRect& rect);
+
+  static constexpr size_t PositionCount = static_cast<size_t>(Position::Center) + 1;
+  std::vector<ItemWrapper>& itemsAt(Position position) { return items[static_cast<size_t>(position)]; }
+
+  // Items are bucketed by position, which is also their index order. The
+  // wrappers are stored by value, the layout owns the items they point to.
+  std::array<std::vector<ItemWrapper>, PositionCount> items;
+  mutable QSize cachedSizeHint;
+  mutable QSize cachedMinimumSize;
 
-  std::vector<ItemWrapper> items;
+  // Resizes are laid out once per frame, the first layout after an
+  // invalidation right away.
+  LayoutScheduler scheduler{ [this] { layoutItems(geometry()); } };
+  bool laidOut = false;
 };
 
 #endif
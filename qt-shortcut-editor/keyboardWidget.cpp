@@ -9,8 +9,10 @@
 #include <QMimeData>
 #include <QMouseEvent>
 #include <QPalette>
+#include <QSizeF>
 #include <QString>
 
+#include <algorithm>
 #include <iostream>
 #include <vector>
 
@@ -26,6 +28,8 @@ namespace {
   float kFunctionKeyWidth = 1.042f;
   float kFunctionKeyHeight = 0.8f;
   float kSpaceWidth = 0.5f;
+  // Keys are never smaller than this, in pixels.
+  float kMinimumKeySize = 37.5f;
 }
 
 KeyButton::KeyButton(const QString& text, QWidget* parent)
@@ -203,8 +207,23 @@ std::vector<RowKeys> keyboardLayout {
   }
 };
 
+// The size of the keyboard in keys.
+static QSizeF LayoutSize()
+{
+  float width = 0;
+  for (const auto& keyboardRow : keyboardLayout) {
+    float column = 0;
+    for (const Key& key : keyboardRow) {
+      column += key.width;
+    }
+    width = std::max(width, column);
+  }
+  return QSizeF(width, keyboardLayout.size());
+}
+
 KeyboardWidget::KeyboardWidget(QWidget* parent)
   : QWidget(parent)
+  , _layoutScheduler([this] { resizeButtons(); })
 {
   setAcceptDrops(true);
   for (auto& keyboardRow : keyboardLayout) {
@@ -257,34 +276,41 @@ KeyboardWidget::KeyboardWidget(QWidget* parent)
     _buttons.push_back(keyboardRowButtons);
   }
 
+  static const QSizeF layoutSize = LayoutSize();
+  setMinimumSize((kMinimumKeySize * layoutSize).toSize());
   resizeButtons();
 }
 
 void KeyboardWidget::resizeButtons()
 {
-  static constexpr float kMultiplier = 37.5f;
-  // const QSize currentSize = size();
+  // Keys grow with the widget, keeping their proportions.
+  static const QSizeF layoutSize = LayoutSize();
+  const float keySize = std::max(kMinimumKeySize, static_cast<float>(
+    std::min(width() / layoutSize.width(), height() / layoutSize.height())));
+
+  // Edges are rounded rather than sizes, so that neighbouring keys stay
+  // flush at any scale.
+  auto edge = [keySize](float position) { return qRound(keySize * position); };
+
   float row = 0;
-  float width = 0;
   for (size_t i = 0; i < keyboardLayout.size(); ++i) {
     float column = 0;
     for (size_t j = 0, buttonColumn = 0; j < keyboardLayout[i].size(); ++j) {
       Key key = keyboardLayout[i][j];
       if (key.key) {
-        _buttons[i][buttonColumn++]->setGeometry(kMultiplier * column, kMultiplier * row,
-          kMultiplier * key.width, kMultiplier * key.height);
+        const QRect rect(QPoint(edge(column), edge(row)),
+                         QPoint(edge(column + key.width) - 1, edge(row + key.height) - 1));
+        LayoutScheduler::setGeometry(_buttons[i][buttonColumn++], rect);
       }
       column += key.width;
     }
-    width = std::max(width, column);
     ++row;
   }
-  setMinimumSize(kMultiplier * width, kMultiplier * row);
 }
 
 void KeyboardWidget::resizeEvent(QResizeEvent* /*event*/)
 {
-  resizeButtons();
+  _layoutScheduler.schedule();
 }
 
 void KeyboardWidget::highlightShortcuts()
@@ -1,6 +1,8 @@
 #ifndef KEYBOARDWIDGET_H
 #define KEYBOARDWIDGET_H
 
+#include "layoutScheduler.h"
+
 #include <QKeySequence>
 #include <QPalette>
 #include <QPoint>
@@ -62,6 +64,8 @@ private:
 
   Qt::KeyboardModifiers _modifiers;
   std::vector<QAction*> _actions;
+
+  LayoutScheduler _layoutScheduler;
 };
 
 #endif
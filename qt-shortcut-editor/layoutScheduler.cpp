@@ -0,0 +1,94 @@
+#include "layoutScheduler.h"
+
+#include <QElapsedTimer>
+#include <QGuiApplication>
+#include <QLayoutItem>
+#include <QScreen>
+#include <QWidget>
+
+namespace {
+  bool coalescing = true;
+  LayoutScheduler::Stats schedulerStats;
+}
+
+LayoutScheduler::LayoutScheduler(std::function<void()> layout, QObject* parent)
+  : QObject(parent)
+  , _layout(std::move(layout))
+{
+  _timer.setSingleShot(true);
+  connect(&_timer, &QTimer::timeout, this, &LayoutScheduler::run);
+}
+
+void LayoutScheduler::schedule()
+{
+  ++schedulerStats.requests;
+  if (!coalescing) {
+    run();
+    return;
+  }
+
+  if (_timer.isActive()) {
+    return;
+  }
+
+  const QScreen* screen = QGuiApplication::primaryScreen();
+  const qreal refreshRate = screen ? screen->refreshRate() : 60.0;
+  _timer.start(qRound(1000.0 / qMax(refreshRate, 1.0)));
+}
+
+void LayoutScheduler::flush()
+{
+  if (_timer.isActive()) {
+    run();
+  }
+}
+
+void LayoutScheduler::run()
+{
+  _timer.stop();
+
+  QElapsedTimer timer;
+  timer.start();
+  _layout();
+  ++schedulerStats.passes;
+  schedulerStats.nanoseconds += timer.nsecsElapsed();
+}
+
+void LayoutScheduler::setGeometry(QWidget* widget, const QRect& rect)
+{
+  if (widget->geometry() == rect) {
+    ++schedulerStats.geometrySkips;
+    return;
+  }
+
+  ++schedulerStats.geometryUpdates;
+  widget->setGeometry(rect);
+}
+
+void LayoutScheduler::setGeometry(QLayoutItem* item, const QRect& rect)
+{
+  // A nested layout keeps its rectangle when it is invalidated, e.g. by an
+  // added child, so it is always forwarded to place its children again.
+  if (!item->layout() && item->geometry() == rect) {
+    ++schedulerStats.geometrySkips;
+    return;
+  }
+
+  ++schedulerStats.geometryUpdates;
+  item->setGeometry(rect);
+}
+
+void LayoutScheduler::setCoalescing(bool enabled)
+{
+  coalescing = enabled;
+}
+
+bool LayoutScheduler::isCoalescing()
+{
+  return coalescing;
+}
+
+LayoutScheduler::Stats& LayoutScheduler::stats()
+{
+  return schedulerStats;
+}
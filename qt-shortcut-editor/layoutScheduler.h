@@ -0,0 +1,54 @@
+#ifndef LAYOUTSCHEDULER_H
+#define LAYOUTSCHEDULER_H
+
+#include <QObject>
+#include <QRect>
+#include <QTimer>
+
+#include <functional>
+
+class QLayoutItem;
+class QWidget;
+
+// Coalesces layout passes into at most one per frame. A live window resize
+// delivers an event for every intermediate size, and laying out children
+// synchronously for each of them repeats work that is replaced a few
+// milliseconds later.
+class LayoutScheduler : public QObject
+{
+public:
+  struct Stats
+  {
+    int requests = 0;
+    int passes = 0;
+    qint64 nanoseconds = 0;
+    int geometryUpdates = 0;
+    int geometrySkips = 0;
+  };
+
+  explicit LayoutScheduler(std::function<void()> layout, QObject* parent = nullptr);
+
+  // Runs the layout within a frame, or right away when coalescing is off.
+  void schedule();
+  // Runs a scheduled layout now.
+  void flush();
+  bool isPending() const { return _timer.isActive(); }
+
+  // These skip children whose rectangle did not change, but not nested
+  // layouts.
+  static void setGeometry(QWidget* widget, const QRect& rect);
+  static void setGeometry(QLayoutItem* item, const QRect& rect);
+
+  // Process wide, so that a benchmark can compare against synchronous layout.
+  static void setCoalescing(bool coalescing);
+  static bool isCoalescing();
+  static Stats& stats();
+
+private:
+  void run();
+
+  std::function<void()> _layout;
+  QTimer _timer;
+};
+
+#endif
@@ -1,10 +1,51 @@
 #include "logo.h"
 
+#include <QThreadPool>
+
+#include <algorithm>
 #include <cmath>
+#include <limits>
+
+// Every primitive writes a fixed number of vertices, so the output offset of
+// each sector is known up front and sectors can be generated in any order.
+static constexpr int FloatsPerVertex = 6;
+static constexpr int QuadVertices = 12;
+static constexpr int ExtrudeVertices = 6;
+static constexpr int StaticVertices = 2 * QuadVertices + 7 * ExtrudeVertices;
+static constexpr int SectorVertices = QuadVertices + 2 * ExtrudeVertices;
+
+// Below this many sectors spinning up the worker threads costs more than it
+// saves.
+static constexpr int ParallelThreshold = 4096;
+
+int Logo::maxSectors()
+{
+  // The float count has to fit count().
+  return static_cast<int>((std::numeric_limits<int>::max() / FloatsPerVertex - StaticVertices) / SectorVertices);
+}
 
-Logo::Logo()
+Logo::Logo(int numSectors, Execution execution)
+  : m_numSectors(std::clamp(numSectors, 1, maxSectors()))
+  , m_count(static_cast<int>((StaticVertices + static_cast<qint64>(SectorVertices) * m_numSectors) * FloatsPerVertex))
 {
-  m_data.resize(2500 * 6);
+  // Left uninitialized on purpose, every float is written exactly once below.
+  m_data.reset(new GLfloat[m_count]);
+
+  if (execution == Execution::Automatic) {
+    execution = m_numSectors >= ParallelThreshold ? Execution::Parallel : Execution::Serial;
+  }
+
+  QThreadPool pool;
+  if (execution == Execution::Parallel) {
+    // Several chunks per thread so that a slow thread does not hold up the
+    // others at the end.
+    const int chunks = std::min(pool.maxThreadCount() * 4, m_numSectors);
+    for (int chunk = 0; chunk < chunks; ++chunk) {
+      const int first = static_cast<int>(static_cast<qint64>(m_numSectors) * chunk / chunks);
+      const int last = static_cast<int>(static_cast<qint64>(m_numSectors) * (chunk + 1) / chunks);
+      pool.start([this, first, last] { generateSectors(first, last); });
+    }
+  }
 
   const GLfloat x1 = 0.06f;
   const GLfloat y1 = -0.14f;
@@ -15,87 +56,100 @@ Logo::Logo()
   const GLfloat x4 = 0.30f;
   const GLfloat y4 = 0.22f;
 
-  quad(x1, y1, x2, y2, y2, x2, y1, x1);
-  quad(x3, y3, x4, y4, y4, x4, y3, x3);
-
-  extrude(x1, y1, x2, y2);
-  extrude(x2, y2, y2, x2);
-  extrude(y2, x2, y1, x1);
-  extrude(y1, x1, x1, y1);
-  extrude(x3, y3, x4, y4);
-  extrude(x4, y4, y4, x4);
-  extrude(y4, x4, y3, x3);
-
-  const int NumSectors = 100;
-
-  for (int i = 0; i < NumSectors; ++i) {
-    GLfloat angle = (i * 2 * M_PI) / NumSectors;
-    GLfloat angleSin = std::sin(angle);
-    GLfloat angleCos = std::cos(angle);
-    const GLfloat x5 = 0.30f * angleSin;
-    const GLfloat y5 = 0.30f * angleCos;
-    const GLfloat x6 = 0.20f * angleSin;
-    const GLfloat y6 = 0.20f * angleCos;
-
-    angle = ((i + 1) * 2 * M_PI) / NumSectors;
-    angleSin = std::sin(angle);
-    angleCos = std::cos(angle);
-    const GLfloat x7 = 0.20f * angleSin;
-    const GLfloat y7 = 0.20f * angleCos;
-    const GLfloat x8 = 0.30f * angleSin;
-    const GLfloat y8 = 0.30f * angleCos;
-
-    quad(x5, y5, x6, y6, x7, y7, x8, y8);
-
-    extrude(x6, y6, x7, y7);
-    extrude(x8, y8, x5, y5);
+  GLfloat* p = m_data.get();
+
+  quad(p, x1, y1, x2, y2, y2, x2, y1, x1);
+  quad(p, x3, y3, x4, y4, y4, x4, y3, x3);
+
+  extrude(p, x1, y1, x2, y2);
+  extrude(p, x2, y2, y2, x2);
+  extrude(p, y2, x2, y1, x1);
+  extrude(p, y1, x1, x1, y1);
+  extrude(p, x3, y3, x4, y4);
+  extrude(p, x4, y4, y4, x4);
+  extrude(p, y4, x4, y3, x3);
+
+  if (execution == Execution::Parallel) {
+    pool.waitForDone();
+  } else {
+    generateSectors(0, m_numSectors);
+  }
+}
+
+void Logo::generateSectors(int first, int last)
+{
+  for (int i = first; i < last; ++i) {
+    const qint64 offset = StaticVertices + static_cast<qint64>(SectorVertices) * i;
+    sector(i, m_data.get() + offset * FloatsPerVertex);
   }
 }
 
-void Logo::add(const QVector3D& v, const QVector3D& n)
+void Logo::sector(int i, GLfloat* p) const
+{
+  GLfloat angle = (i * 2 * M_PI) / m_numSectors;
+  GLfloat angleSin = std::sin(angle);
+  GLfloat angleCos = std::cos(angle);
+  const GLfloat x5 = 0.30f * angleSin;
+  const GLfloat y5 = 0.30f * angleCos;
+  const GLfloat x6 = 0.20f * angleSin;
+  const GLfloat y6 = 0.20f * angleCos;
+
+  angle = ((i + 1) * 2 * M_PI) / m_numSectors;
+  angleSin = std::sin(angle);
+  angleCos = std::cos(angle);
+  const GLfloat x7 = 0.20f * angleSin;
+  const GLfloat y7 = 0.20f * angleCos;
+  const GLfloat x8 = 0.30f * angleSin;
+  const GLfloat y8 = 0.30f * angleCos;
+
+  quad(p, x5, y5, x6, y6, x7, y7, x8, y8);
+
+  extrude(p, x6, y6, x7, y7);
+  extrude(p, x8, y8, x5, y5);
+}
+
+void Logo::add(GLfloat*& p, const QVector3D& v, const QVector3D& n)
 {
-  GLfloat* p = m_data.data() + m_count;
   *p++ = v.x();
   *p++ = v.y();
   *p++ = v.z();
   *p++ = n.x();
   *p++ = n.y();
   *p++ = n.z();
-  m_count += 6;
 }
 
-void Logo::quad(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, GLfloat x3, GLfloat y3, GLfloat x4, GLfloat y4)
+void Logo::quad(GLfloat*& p, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2, GLfloat x3, GLfloat y3, GLfloat x4, GLfloat y4)
 {
   QVector3D n = QVector3D::normal(QVector3D(x4 - x1, y4 - y1, 0.0f), QVector3D(x2 - x1, y2 - y1, 0.0f));
 
-  add(QVector3D(x1, y1, -0.05f), n);
-  add(QVector3D(x4, y4, -0.05f), n);
-  add(QVector3D(x2, y2, -0.05f), n);
+  add(p, QVector3D(x1, y1, -0.05f), n);
+  add(p, QVector3D(x4, y4, -0.05f), n);
+  add(p, QVector3D(x2, y2, -0.05f), n);
 
-  add(QVector3D(x3, y3, -0.05f), n);
-  add(QVector3D(x2, y2, -0.05f), n);
-  add(QVector3D(x4, y4, -0.05f), n);
+  add(p, QVector3D(x3, y3, -0.05f), n);
+  add(p, QVector3D(x2, y2, -0.05f), n);
+  add(p, QVector3D(x4, y4, -0.05f), n);
 
   n = QVector3D::normal(QVector3D(x1 - x4, y1 - y4, 0.0f), QVector3D(x2 - x4, y2 - y4, 0.0f));
 
-  add(QVector3D(x4, y4, 0.05f), n);
-  add(QVector3D(x1, y1, 0.05f), n);
-  add(QVector3D(x2, y2, 0.05f), n);
+  add(p, QVector3D(x4, y4, 0.05f), n);
+  add(p, QVector3D(x1, y1, 0.05f), n);
+  add(p, QVector3D(x2, y2, 0.05f), n);
 
-  add(QVector3D(x2, y2, 0.05f), n);
-  add(QVector3D(x3, y3, 0.05f), n);
-  add(QVector3D(x4, y4, 0.05f), n);
+  add(p, QVector3D(x2, y2, 0.05f), n);
+  add(p, QVector3D(x3, y3, 0.05f), n);
+  add(p, QVector3D(x4, y4, 0.05f), n);
 }
 
-void Logo::extrude(GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2)
+void Logo::extrude(GLfloat*& p, GLfloat x1, GLfloat y1, GLfloat x2, GLfloat y2)
 {
   QVector3D n = QVector3D::normal(QVector3D(0.0f, 0.0f, -0.1f), QVector3D(x2 - x1, y2 - y1, 0.0f));
 
-  add(QVector3D(x1, y1, +0.05f), n);
-  add(QVector3D(x1, y1, -0.05f), n);
-  add(QVector3D(x2, y2, +0.05f), n);
+  add(p, QVector3D(x1, y1, +0.05f), n);
+  add(p, QVector3D(x1, y1, -0.05f), n);
+  add(p, QVector3D(x2, y2, +0.05f), n);
 
-  add(QVector3D(x2, y2, -0.05f), n);
-  add(QVector3D(x2, y2, +0.05f), n);
-  add(QVector3D(x1, y1, -0.05f), n);
+  add(p, QVector3D(x2, y2, -0.05f), n);
+  add(p, QVector3D(x2, y2, +0.05f), n);
+  add(p, QVector3D(x1, y1, -0.05f), n);
 }
@@ -0,0 +1,241 @@
+#include "logoRenderer.h"
+
+#include <QOpenGLContext>
+#include <QOpenGLShaderProgram>
+
+#include <cmath>
+
+LogoRenderer::LogoRenderer()
+{
+  m_core = QSurfaceFormat::defaultFormat().profile() == QSurfaceFormat::CoreProfile;
+}
+
+void LogoRenderer::setAnimated(bool animated)
+{
+  m_animated = animated;
+  m_time.start();
+}
+
+void LogoRenderer::cleanup()
+{
+  if (m_profiler) {
+    m_profiler->cleanup();
+  }
+  m_logoStream.destroy();
+  m_logoVbo.destroy();
+  delete m_program;
+  m_program = nullptr;
+}
+
+static const char* vertexShaderSourceCore =
+  "#version 150\n"
+  "in vec4 vertex;\n"
+  "in vec3 normal;\n"
+  "out vec3 vert;\n"
+  "out vec3 vertNormal;\n"
+  "uniform mat4 projMatrix;\n"
+  "uniform mat4 mvMatrix;\n"
+  "uniform mat3 normalMatrix;\n"
+  "void main() {\n"
+  "   vert = vertex.xyz;\n"
+  "   vertNormal = normalMatrix * normal;\n"
+  "   gl_Position = projMatrix * mvMatrix * vertex;\n"
+  "}\n";
+
+static const char* fragmentShaderSourceCore =
+  "#version 150\n"
+  "in highp vec3 vert;\n"
+  "in highp vec3 vertNormal;\n"
+  "out highp vec4 fragColor;\n"
+  "uniform highp vec3 lightPos;\n"
+  "void main() {\n"
+  "   highp vec3 L = normalize(lightPos - vert);\n"
+  "   highp float NL = max(dot(normalize(vertNormal), L), 0.0);\n"
+  "   highp vec3 color = vec3(0.39, 1.0, 0.0);\n"
+  "   highp vec3 col = clamp(color * 0.2 + color * 0.8 * NL, 0.0, 1.0);\n"
+  "   fragColor = vec4(col, 1.0);\n"
+  "}\n";
+
+static const char* vertexShaderSource =
+  "attribute vec4 vertex;\n"
+  "attribute vec3 normal;\n"
+  "varying vec3 vert;\n"
+  "varying vec3 vertNormal;\n"
+  "uniform mat4 projMatrix;\n"
+  "uniform mat4 mvMatrix;\n"
+  "uniform mat3 normalMatrix;\n"
+  "void main() {\n"
+  "   vert = vertex.xyz;\n"
+  "   vertNormal = normalMatrix * normal;\n"
+  "   gl_Position = projMatrix * mvMatrix * vertex;\n"
+  "}\n";
+
+static const char* fragmentShaderSource =
+  "varying highp vec3 vert;\n"
+  "varying highp vec3 vertNormal;\n"
+  "uniform highp vec3 lightPos;\n"
+  "void main() {\n"
+  "   highp vec3 L = normalize(lightPos - vert);\n"
+  "   highp float NL = max(dot(normalize(vertNormal), L), 0.0);\n"
+  "   highp vec3 color = vec3(0.39, 1.0, 0.0);\n"
+  "   highp vec3 col = clamp(color * 0.2 + color * 0.8 * NL, 0.0, 1.0);\n"
+  "   gl_FragColor = vec4(col, 1.0);\n"
+  "}\n";
+
+void LogoRenderer::initialize()
+{
+  initializeOpenGLFunctions();
+  glClearColor(0, 0, 0, 0);
+
+  // The context is recreated whenever the widget changes top-level window.
+  // Cacheable shaders are not compiled when they are added. On link Qt looks
+  // the program binary up by the hash of the sources, first in memory and then
+  // in the shader disk cache, and only compiles on a miss. Reparenting the
+  // viewport or restarting the application reuses the binary. Set
+  // QT_DISABLE_SHADER_DISK_CACHE to compare against compiling every time.
+  m_program = new QOpenGLShaderProgram;
+  m_program->addCacheableShaderFromSourceCode(QOpenGLShader::Vertex, m_core ? vertexShaderSourceCore : vertexShaderSource);
+  m_program->addCacheableShaderFromSourceCode(QOpenGLShader::Fragment, m_core ? fragmentShaderSourceCore : fragmentShaderSource);
+  m_program->bindAttributeLocation("vertex", 0);
+  m_program->bindAttributeLocation("normal", 1);
+  m_program->link();
+
+  m_program->bind();
+  m_projMatrixLoc = m_program->uniformLocation("projMatrix");
+  m_mvMatrixLoc = m_program->uniformLocation("mvMatrix");
+  m_normalMatrixLoc = m_program->uniformLocation("normalMatrix");
+  m_lightPosLoc = m_program->uniformLocation("lightPos");
+
+  // Create a vertex array object. In OpenGL ES 2.0 and OpenGL 2.x
+  // implementations this is optional and support may not be present
+  // at all. Nonetheless the below code works in all cases and makes
+  // sure there is a VAO when one is needed.
+  m_vao.create();
+  QOpenGLVertexArrayObject::Binder vaoBinder(&m_vao);
+
+  // Setup our vertex buffer object.
+  m_logoVbo.create();
+  m_logoVbo.bind();
+  m_logoVbo.allocate(m_logo.constData(), m_logo.count() * sizeof(GLfloat));
+
+  // Store the vertex attribute bindings for the program.
+  setupVertexAttribs(m_logoVbo);
+  vaoBinder.release();
+
+  // The animated logo is rewritten every frame into a streaming buffer with
+  // its own vertex array object.
+  m_streamVao.create();
+  m_streamVao.bind();
+  m_logoStream.create(static_cast<int>(m_logo.count() * sizeof(GLfloat)));
+  setupVertexAttribs(m_logoStream.buffer());
+  m_streamVao.release();
+  m_time.start();
+
+  // Our camera never changes in this example.
+  m_camera.setToIdentity();
+  m_camera.translate(0, 0, -1);
+
+  // Light position is fixed.
+  m_program->setUniformValue(m_lightPosLoc, QVector3D(0, 0, 70));
+
+  m_program->release();
+}
+
+void LogoRenderer::setupVertexAttribs(QOpenGLBuffer& buffer)
+{
+  buffer.bind();
+  QOpenGLFunctions* f = QOpenGLContext::currentContext()->functions();
+  f->glEnableVertexAttribArray(0);
+  f->glEnableVertexAttribArray(1);
+  f->glVertexAttribPointer(0, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat),
+                           nullptr);
+  f->glVertexAttribPointer(1, 3, GL_FLOAT, GL_FALSE, 6 * sizeof(GLfloat),
+                           reinterpret_cast<void*>(3 * sizeof(GLfloat)));
+  buffer.release();
+}
+
+int LogoRenderer::streamLogo()
+{
+  // Twist the logo around its axis with a ripple travelling outwards from
+  // the center. Positions and normals are rotated alike.
+  const GLfloat seconds = m_time.elapsed() / 1000.0f;
+  const GLfloat* src = m_logo.constData();
+  GLfloat* dst = static_cast<GLfloat*>(m_logoStream.map());
+  for (int i = 0; i < m_logo.count(); i += 6) {
+    const GLfloat x = src[i];
+    const GLfloat y = src[i + 1];
+    const GLfloat angle = 0.3f * std::sin(2.0f * seconds - 12.0f * std::sqrt(x * x + y * y));
+    const GLfloat c = std::cos(angle);
+    const GLfloat s = std::sin(angle);
+    dst[i] = c * x - s * y;
+    dst[i + 1] = s * x + c * y;
+    dst[i + 2] = src[i + 2];
+    dst[i + 3] = c * src[i + 3] - s * src[i + 4];
+    dst[i + 4] = s * src[i + 3] + c * src[i + 4];
+    dst[i + 5] = src[i + 5];
+  }
+  m_logoStream.unmap(static_cast<int>(m_logo.count() * sizeof(GLfloat)));
+
+  // The ring regions are a whole number of vertices apart, so the region is
+  // selected through the first vertex instead of new attribute pointers.
+  return m_logoStream.regionOffset() / static_cast<int>(6 * sizeof(GLfloat));
+}
+
+void LogoRenderer::render(int xRot, int yRot, int zRot)
+{
+  if (m_profiler) {
+    m_profiler->beginFrame();
+  }
+
+  glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+  glEnable(GL_DEPTH_TEST);
+  glEnable(GL_CULL_FACE);
+
+  m_world.setToIdentity();
+  m_world.rotate(180.0f - (xRot / 16.0f), 1, 0, 0);
+  m_world.rotate(yRot / 16.0f, 0, 1, 0);
+  m_world.rotate(zRot / 16.0f, 0, 0, 1);
+
+  QOpenGLVertexArrayObject& vao = m_animated ? m_streamVao : m_vao;
+  QOpenGLVertexArrayObject::Binder vaoBinder(&vao);
+  if (m_profiler) {
+    m_profiler->endPhase(FrameProfiler::Setup);
+  }
+
+  GLint first = 0;
+  if (m_animated) {
+    first = streamLogo();
+  }
+  if (m_profiler) {
+    m_profiler->endPhase(FrameProfiler::Stream);
+  }
+
+  if (!vao.isCreated()) {
+    setupVertexAttribs(m_animated ? m_logoStream.buffer() : m_logoVbo);
+  }
+
+  m_program->bind();
+  m_program->setUniformValue(m_projMatrixLoc, m_proj);
+  m_program->setUniformValue(m_mvMatrixLoc, m_camera * m_world);
+  QMatrix3x3 normalMatrix = m_world.normalMatrix();
+  m_program->setUniformValue(m_normalMatrixLoc, normalMatrix);
+
+  glDrawArrays(GL_TRIANGLES, first, m_logo.vertexCount());
+
+  m_program->release();
+
+  if (m_animated) {
+    m_logoStream.fence();
+  }
+
+  if (m_profiler) {
+    m_profiler->endPhase(FrameProfiler::Draw);
+    m_profiler->endFrame();
+  }
+}
+
+void LogoRenderer::resize(int w, int h)
+{
+  m_proj.setToIdentity();
+  m_proj.perspective(45.0f, static_cast<GLfloat>(w) / h, 0.01f, 100.0f);
+}
@@ -0,0 +1,61 @@
+#ifndef LOGORENDERER_H
+#define LOGORENDERER_H
+
+#include "frameProfiler.h"
+#include "logo.h"
+#include "streamingBuffer.h"
+
+#include <QElapsedTimer>
+#include <QMatrix4x4>
+
+#include <QOpenGLBuffer>
+#include <QOpenGLFunctions>
+#include <QOpenGLVertexArrayObject>
+
+class QOpenGLShaderProgram;
+
+// The GL side of OpenGLWidget. It only relies on a current context, so the
+// same render path can draw into the widget or into an offscreen framebuffer.
+class LogoRenderer : protected QOpenGLFunctions
+{
+public:
+  LogoRenderer();
+
+  void initialize();
+  void cleanup();
+  bool isInitialized() const { return m_program != nullptr; }
+
+  void resize(int width, int height);
+  void render(int xRot, int yRot, int zRot);
+
+  bool isAnimated() const { return m_animated; }
+  void setAnimated(bool animated);
+  const StreamingBuffer::Stats& streamStats() const { return m_logoStream.stats(); }
+
+  // Not owned. Profiling costs nothing while no profiler is set.
+  void setProfiler(FrameProfiler* profiler) { m_profiler = profiler; }
+
+private:
+  void setupVertexAttribs(QOpenGLBuffer& buffer);
+  int streamLogo();
+
+  bool m_core;
+  bool m_animated = false;
+  Logo m_logo;
+  QOpenGLVertexArrayObject m_vao;
+  QOpenGLBuffer m_logoVbo;
+  QOpenGLVertexArrayObject m_streamVao;
+  StreamingBuffer m_logoStream;
+  QElapsedTimer m_time;
+  QOpenGLShaderProgram* m_program = nullptr;
+  FrameProfiler* m_profiler = nullptr;
+  int m_projMatrixLoc = 0;
+  int m_mvMatrixLoc = 0;
+  int m_normalMatrixLoc = 0;
+  int m_lightPosLoc = 0;
+  QMatrix4x4 m_proj;
+  QMatrix4x4 m_camera;
+  QMatrix4x4 m_world;
+};
+
+#endif
@@ -1,18 +1,15 @@
 #ifndef OPENGLWIDGET_H
 #define OPENGLWIDGET_H
 
-#include "logo.h"
+#include "logoRenderer.h"
 
-#include <QMatrix4x4>
-#include <QOpenGLBuffer>
-#include <QOpenGLFunctions>
-#include <QOpenGLVertexArrayObject>
 #include <QOpenGLWidget>
 
+#include <memory>
+
 class QAction;
-class QOpenGLShaderProgram;
 
-class OpenGLWidget : public QOpenGLWidget, protected QOpenGLFunctions
+class OpenGLWidget : public QOpenGLWidget
 {
   Q_OBJECT
 
@@ -23,10 +20,18 @@ public:
   QSize minimumSizeHint() const override;
   QSize sizeHint() const override;
 
+  bool isAnimated() const { return m_renderer.isAnimated(); }
+  const StreamingBuffer::Stats& streamStats() const { return m_renderer.streamStats(); }
+
+  bool isProfiling() const { return m_profiler != nullptr; }
+  const FrameProfiler* profiler() const { return m_profiler.get(); }
+
 public Q_SLOTS:
   void setXRotation(int angle);
   void setYRotation(int angle);
   void setZRotation(int angle);
+  void setAnimated(bool animated);
+  void setProfiling(bool profiling);
   void cleanup();
 
 Q_SIGNALS:
@@ -44,29 +49,20 @@ protected:
 
 private:
   void createActions();
-  void setupVertexAttribs();
 
-  bool m_core;
   int m_xRot = 0;
   int m_yRot = 0;
   int m_zRot = 0;
   QPoint m_lastPos;
-  Logo m_logo;
-  QOpenGLVertexArrayObject m_vao;
-  QOpenGLBuffer m_logoVbo;
-  QOpenGLShaderProgram* m_program = nullptr;
-  int m_projMatrixLoc = 0;
-  int m_mvMatrixLoc = 0;
-  int m_normalMatrixLoc = 0;
-  int m_lightPosLoc = 0;
-  QMatrix4x4 m_proj;
-  QMatrix4x4 m_camera;
-  QMatrix4x4 m_world;
+  LogoRenderer m_renderer;
+  std::unique_ptr<FrameProfiler> m_profiler;
 
   QAction* _selectAction;
   QAction* _translateAction;
   QAction* _rotateAction;
   QAction* _scaleAction;
+  QAction* _animateAction;
+  QAction* _profileAction;
 };
 
 #endif
@@ -133,6 +133,10 @@ KeyboardShortcutsPreferencesPage::KeyboardShortcutsPreferencesPage(QWidget* pare
 }
 
 const QString kShortcutEditorKey = "shortcutEditor";
+const QString kShortcutEditorExpandStateKey = "shortcutEditorExpandState";
+// The expand state is also kept between dialogs of the same session, it is
+// only read from the settings once.
+static bool sExpandStateLoaded = false;
 
 void KeyboardShortcutsPreferencesPage::saveSettings()
 {
@@ -156,11 +160,16 @@ void KeyboardShortcutsPreferencesPage::saveSettings()
     ss << ";;";
   }
   settings.setValue(kShortcutEditorKey, QString::fromStdString(ss.str()));
+  settings.setValue(kShortcutEditorExpandStateKey, ShortcutEditorExpandState::expandedKeys());
 }
 
 void KeyboardShortcutsPreferencesPage::loadSettings()
 {
   QSettings settings(QSettings::IniFormat, QSettings::UserScope, QCoreApplication::organizationName(), QCoreApplication::applicationName());
+  if (!sExpandStateLoaded) {
+    ShortcutEditorExpandState::setExpandedKeys(settings.value(kShortcutEditorExpandStateKey).toStringList());
+    sExpandStateLoaded = true;
+  }
   std::string data = settings.value(kShortcutEditorKey).toString().toStdString();
   const char* s = data.c_str();
   std::string actionId;
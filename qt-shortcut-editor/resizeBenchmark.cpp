@@ -0,0 +1,119 @@
+#include "borderLayout.h"
+#include "keyboardWidget.h"
+#include "layoutScheduler.h"
+
+#include <QApplication>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QLabel>
+#include <QTextStream>
+
+#include <iostream>
+#include <vector>
+
+// Usage: ResizeBenchmark [trace]
+//
+// Replays a window resize trace against a BorderLayout hosting a
+// KeyboardWidget, once with synchronous layouts and once coalesced, and
+// prints the layout passes and child geometry changes each needed.
+//
+// A trace has one "<milliseconds> <width> <height>" line per resize event,
+// as recorded from a live window drag. Without one, a two second drag with a
+// resize every 8 ms is replayed. QT_QPA_PLATFORM=offscreen runs it without a
+// display.
+struct Resize
+{
+  qint64 time;
+  QSize size;
+};
+
+static std::vector<Resize> LoadTrace(const QString& path)
+{
+  std::vector<Resize> trace;
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    std::cerr << "Failed to read " << qPrintable(path) << std::endl;
+    return trace;
+  }
+
+  QTextStream stream(&file);
+  while (!stream.atEnd()) {
+    const QStringList fields = stream.readLine().split(' ', Qt::SkipEmptyParts);
+    if (fields.size() == 3) {
+      trace.push_back({ fields[0].toLongLong(), QSize(fields[1].toInt(), fields[2].toInt()) });
+    }
+  }
+  return trace;
+}
+
+static std::vector<Resize> SyntheticTrace()
+{
+  std::vector<Resize> trace;
+  for (qint64 time = 0; time <= 2000; time += 8) {
+    const double t = time / 2000.0;
+    trace.push_back({ time, QSize(1000 + qRound(600 * t), 400 + qRound(300 * t)) });
+  }
+  return trace;
+}
+
+static void Replay(const std::vector<Resize>& trace, bool coalescing)
+{
+  LayoutScheduler::setCoalescing(coalescing);
+
+  QWidget window;
+  BorderLayout* layout = new BorderLayout;
+  layout->addWidget(new KeyboardWidget, BorderLayout::Position::Center);
+  layout->addWidget(new QLabel("North"), BorderLayout::Position::North);
+  layout->addWidget(new QLabel("West"), BorderLayout::Position::West);
+  layout->addWidget(new QLabel("East 1"), BorderLayout::Position::East);
+  layout->addWidget(new QLabel("East 2"), BorderLayout::Position::East);
+  layout->addWidget(new QLabel("South"), BorderLayout::Position::South);
+  window.setLayout(layout);
+  window.resize(trace.front().size);
+  window.show();
+  QCoreApplication::processEvents();
+
+  LayoutScheduler::stats() = LayoutScheduler::Stats();
+
+  QElapsedTimer clock;
+  clock.start();
+  for (const Resize& resize : trace) {
+    // Whatever the event loop does between two resizes of a drag.
+    const qint64 due = resize.time - trace.front().time;
+    while (clock.elapsed() < due) {
+      QCoreApplication::processEvents(QEventLoop::AllEvents, static_cast<int>(due - clock.elapsed()));
+    }
+    window.resize(resize.size);
+    QCoreApplication::processEvents();
+  }
+
+  // The last coalesced pass runs within a frame.
+  const qint64 end = clock.elapsed() + 50;
+  while (clock.elapsed() < end) {
+    QCoreApplication::processEvents(QEventLoop::AllEvents, static_cast<int>(end - clock.elapsed()));
+  }
+
+  const LayoutScheduler::Stats& stats = LayoutScheduler::stats();
+  std::cout << (coalescing ? "coalesced:   " : "synchronous: ")
+            << stats.requests << " requests, "
+            << stats.passes << " passes, "
+            << stats.nanoseconds / 1e6 << " ms in layout, "
+            << stats.geometryUpdates << " geometry changes, "
+            << stats.geometrySkips << " unchanged" << std::endl;
+}
+
+int main(int argc, char* argv[])
+{
+  QApplication app(argc, argv);
+
+  const std::vector<Resize> trace = argc > 1 ? LoadTrace(argv[1]) : SyntheticTrace();
+  if (trace.empty()) {
+    std::cerr << "Empty trace" << std::endl;
+    return 1;
+  }
+
+  std::cout << trace.size() << " resizes over " << trace.back().time - trace.front().time << " ms" << std::endl;
+  Replay(trace, false);
+  Replay(trace, true);
+  return 0;
+}
@@ -24,9 +24,14 @@
 #include <QUndoStack>
 #include <QVBoxLayout>
 
+#include <algorithm>
 #include <iostream>
+#include <unordered_map>
+#include <vector>
 
-static ShortcutEditorExpandState sShortcutEditorCurrentExpandState = {};
+static std::unordered_map<QString, int> sExpandStateIds;
+static std::vector<QString> sExpandStateKeys;
+static std::vector<bool> sExpandStateBits;
 
 static SearchToolButtonState sSearchToolButtonState = {
   QString("Name"),
@@ -34,9 +39,55 @@ static SearchToolButtonState sSearchToolButtonState = {
   true,
   true,
   true,
+  false,
   {}
 };
 
+int ShortcutEditorExpandState::intern(const QString& key)
+{
+  auto it = sExpandStateIds.find(key);
+  if (it != sExpandStateIds.end()) {
+    return it->second;
+  }
+
+  const int id = static_cast<int>(sExpandStateKeys.size());
+  sExpandStateIds.insert({key, id});
+  sExpandStateKeys.push_back(key);
+  sExpandStateBits.push_back(false);
+  return id;
+}
+
+bool ShortcutEditorExpandState::isExpanded(int id)
+{
+  return id >= 0 && static_cast<size_t>(id) < sExpandStateBits.size() && sExpandStateBits[id];
+}
+
+void ShortcutEditorExpandState::setExpanded(int id, bool expanded)
+{
+  if (id >= 0 && static_cast<size_t>(id) < sExpandStateBits.size()) {
+    sExpandStateBits[id] = expanded;
+  }
+}
+
+QStringList ShortcutEditorExpandState::expandedKeys()
+{
+  QStringList keys;
+  for (size_t id = 0; id < sExpandStateBits.size(); ++id) {
+    if (sExpandStateBits[id]) {
+      keys.push_back(sExpandStateKeys[id]);
+    }
+  }
+  return keys;
+}
+
+void ShortcutEditorExpandState::setExpandedKeys(const QStringList& keys)
+{
+  std::fill(sExpandStateBits.begin(), sExpandStateBits.end(), false);
+  for (const QString& key : keys) {
+    sExpandStateBits[intern(key)] = true;
+  }
+}
+
 AssignShortcutCommand::AssignShortcutCommand(QAction* action, QKeySequence newShortcut, QUndoCommand *parent)
   : QUndoCommand(parent)
 {
@@ -78,93 +129,6 @@ void AssignShortcutCommand::redo()
   }
 }
 
-ShortcutEditorModelItem::ShortcutEditorModelItem(const std::vector<QVariant>& data, const QString& id, ShortcutEditorModelItem* parent)
-  : _itemData(data)
-  , _parentItem(parent)
-  , _id(id)
-{
-}
-
-ShortcutEditorModelItem::~ShortcutEditorModelItem()
-{
-  qDeleteAll(_childItems);
-}
-
-void ShortcutEditorModelItem::appendChild(ShortcutEditorModelItem* item)
-{
-  _childItems.push_back(item);
-}
-
-ShortcutEditorModelItem* ShortcutEditorModelItem::child(int row)
-{
-  if (row < 0 || static_cast<size_t>(row) >= _childItems.size()) {
-    return nullptr;
-  }
-
-  return _childItems.at(row);
-}
-
-int ShortcutEditorModelItem::childCount() const
-{
-  return _childItems.size();
-}
-
-int ShortcutEditorModelItem::row() const
-{
-  if (_parentItem) {
-    auto it = std::find(_parentItem->_childItems.cbegin(), _parentItem->_childItems.cend(), const_cast<ShortcutEditorModelItem*>(this));
-    if (it != _parentItem->_childItems.cend()) {
-      return std::distance(_parentItem->_childItems.cbegin(), it);
-    }
-    else {
-      return -1;
-    }
-  }
-
-  return 0;
-}
-
-int ShortcutEditorModelItem::columnCount() const
-{
-    return _itemData.size();
-}
-
-QVariant ShortcutEditorModelItem::data(int column) const
-{
-  if (column < 0 || static_cast<size_t>(column) >= _itemData.size()) {
-    return QVariant();
-  }
-
-  QVariant columnVariant = _itemData.at(column);
-  if (column != static_cast<int>(Column::Shortcut) || columnVariant.canConvert<QString>()) {
-    return columnVariant;
-  }
-
-  QAction* action = static_cast<QAction*>(columnVariant.value<void*>());
-  if (!action) {
-    return QVariant();
-  }
-  QKeySequence keySequence = action->shortcut();
-  QString keySequenceString = keySequence.toString(QKeySequence::NativeText);
-  return keySequenceString;
-}
-
-ShortcutEditorModelItem* ShortcutEditorModelItem::parentItem()
-{
-  return _parentItem;
-}
-
-const QString& ShortcutEditorModelItem::id() const
-{
-  return _id;
-}
-
-QAction* ShortcutEditorModelItem::action() const
-{
-  QVariant actionVariant = _itemData.at(static_cast<int>(Column::Shortcut));
-  return static_cast<QAction*>(actionVariant.value<void*>());
-}
-
 ShortcutEditorDelegate::ShortcutEditorDelegate(QObject* parent)
   : QStyledItemDelegate(parent)
 {
@@ -235,10 +199,9 @@ bool ShortcutEditorDelegate::eventFilter(QObject* /*object*/, QEvent* /*event*/)
 }
 
 ShortcutEditorModel::ShortcutEditorModel(QObject* parent)
-  : QAbstractItemModel(parent)
+  : ActionTreeModel(static_cast<int>(Column::Shortcut) + 1, parent)
 {
   std::cout << "TEST SHORTCUT EDITOR MODEL CONSTRUCTOR" << std::endl;
-  rootItem = new ShortcutEditorModelItem({tr("Name"), tr("Shortcut")}, QString("root"));
   _hoverTooltip =
     "Define the keyboard shortcuts for any action available";
   _undoStack = new QUndoStack(this);
@@ -247,13 +210,12 @@ ShortcutEditorModel::ShortcutEditorModel(QObject* parent)
 ShortcutEditorModel::~ShortcutEditorModel()
 {
   std::cout << "TEST SHORTCUT EDITOR MODEL DESTRUCTOR" << std::endl;
-  delete rootItem;
 }
 
 void ShortcutEditorModel::setActions()
 {
   beginResetModel();
-  setupModelData(rootItem);
+  setupModelData(rootItem());
   endResetModel();
 }
 
@@ -267,85 +229,17 @@ QUndoStack* ShortcutEditorModel::undoStack() const
   return _undoStack;
 }
 
-QModelIndex ShortcutEditorModel::index(int row, int column, const QModelIndex& parent) const
-{
-  // std::cout << "TEST CREATE INDEX 1, ROW: " << row << ", COLUMN: " << column << std::endl;
-  if (!hasIndex(row, column, parent)) {
-    return QModelIndex();
-  }
-  // std::cout << "TEST CREATE INDEX 2, ROW: " << row << ", COLUMN: " << column << std::endl;
-
-  ShortcutEditorModelItem* parentItem;
-
-  if (!parent.isValid()) {
-    parentItem = rootItem;
-  }
-  else {
-    parentItem = static_cast<ShortcutEditorModelItem*>(parent.internalPointer());
-  }
-
-  ShortcutEditorModelItem* childItem = parentItem->child(row);
-  if (childItem) {
-    // std::cout << "TEST CREATE INDEX 3, ROW: " << row << ", COLUMN: " << column << std::endl;
-    return createIndex(row, column, childItem);
-  }
-
-  return QModelIndex();
-}
-
-QModelIndex ShortcutEditorModel::parent(const QModelIndex& index) const
-{
-  if (!index.isValid()) {
-    return QModelIndex();
-  }
-
-  ShortcutEditorModelItem* childItem = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-  ShortcutEditorModelItem* parentItem = childItem->parentItem();
-
-  if (parentItem == rootItem) {
-    return QModelIndex();
-  }
-
-  return createIndex(parentItem->row(), 0, parentItem);
-}
-
-int ShortcutEditorModel::rowCount(const QModelIndex& parent) const
-{
-  ShortcutEditorModelItem* parentItem;
-  if (parent.column() > 0) {
-    return 0;
-  }
-
-  if (!parent.isValid()) {
-    parentItem = rootItem;
-  }
-  else {
-    parentItem = static_cast<ShortcutEditorModelItem*>(parent.internalPointer());
-  }
-
-  return parentItem->childCount();
-}
-
-int ShortcutEditorModel::columnCount(const QModelIndex& parent) const
-{
-  if (parent.isValid()) {
-    return static_cast<ShortcutEditorModelItem*>(parent.internalPointer())->columnCount();
-  }
-
-  return rootItem->columnCount();
-}
-
 QVariant ShortcutEditorModel::data(const QModelIndex& index, int role) const
 {
   if (!index.isValid()) {
     return QVariant();
   }
 
-  ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
+  const ShortcutEditorItemData& itemData = itemFromIndex(index)->data();
 
   if (role == Qt::ForegroundRole
       && index.column() == static_cast<int>(Column::Shortcut)) {
-    QAction* action = item->action();
+    QAction* action = itemData.action;
     if (!action) {
       return QVariant();
     }
@@ -360,7 +254,17 @@ QVariant ShortcutEditorModel::data(const QModelIndex& index, int role) const
     return QVariant();
   }
 
-  return item->data(index.column());
+  switch (static_cast<Column>(index.column())) {
+    case Column::Name:
+      return itemData.name;
+    case Column::Shortcut:
+      if (!itemData.action) {
+        return QVariant();
+      }
+      return itemData.action->shortcut().toString(QKeySequence::NativeText);
+  }
+
+  return QVariant();
 }
 
 Qt::ItemFlags ShortcutEditorModel::flags(const QModelIndex& index) const
@@ -382,8 +286,15 @@ Qt::ItemFlags ShortcutEditorModel::flags(const QModelIndex& index) const
 
 QVariant ShortcutEditorModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
-    return rootItem->data(section);
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return QVariant();
+  }
+
+  switch (static_cast<Column>(section)) {
+    case Column::Name:
+      return tr("Name");
+    case Column::Shortcut:
+      return tr("Shortcut");
   }
 
   return QVariant();
@@ -428,24 +339,21 @@ void ShortcutEditorModel::setupModelData(ShortcutEditorModelItem* parent)
     }
   }
 
-  QAction* nullAction = nullptr;
+  parent->clear();
   const QString contextIdPrefix = "root";
   // Go through each context, one context - many categories each iteration
   for (const auto& contextLevel : _actionsMap) {
+    const int contextIndex = ActionManager::getContextIndex(contextLevel.first.toStdString());
     // TODO: make it "tr()".
-    ShortcutEditorModelItem* contextLevelItem = new ShortcutEditorModelItem({contextLevel.first, QVariant::fromValue(nullAction)}, contextIdPrefix + contextLevel.first, parent);
-    parent->appendChild(contextLevelItem);
+    ShortcutEditorModelItem* contextLevelItem = parent->appendChild({contextLevel.first, nullptr, ShortcutEditorExpandState::intern(contextIdPrefix + contextLevel.first), contextIndex});
     // Go through each category, one category - many actions each iteration
     for (const auto& categoryLevel : contextLevel.second) {
-      ShortcutEditorModelItem* categoryLevelItem = new ShortcutEditorModelItem({categoryLevel.first, QVariant::fromValue(nullAction)}, contextLevel.first + categoryLevel.first, contextLevelItem);
-      contextLevelItem->appendChild(categoryLevelItem);
+      ShortcutEditorModelItem* categoryLevelItem = contextLevelItem->appendChild({categoryLevel.first, nullptr, ShortcutEditorExpandState::intern(contextLevel.first + categoryLevel.first)});
       for (const auto& action : categoryLevel.second) {
-        QString name = action->text();
-        if (name.isEmpty() || action == nullptr) {
+        if (action == nullptr || action->text().isEmpty()) {
           continue;
         }
-        ShortcutEditorModelItem* actionLevelItem = new ShortcutEditorModelItem({name, QVariant::fromValue(reinterpret_cast<void*>(action))}, categoryLevel.first + name, categoryLevelItem);
-        categoryLevelItem->appendChild(actionLevelItem);
+        categoryLevelItem->appendChild({action->text(), action, -1, contextIndex});
       }
     }
   }
@@ -455,7 +363,7 @@ void ShortcutEditorModel::setupModelData(ShortcutEditorModelItem* parent)
 
 void ShortcutEditorModel::setShortcut(ShortcutEditorModelItem* item, const QString& shortcutString, const QModelIndex& index)
 {
-  QAction* itemAction = item->action();
+  QAction* itemAction = item->data().action;
   if (itemAction) {
     QUndoCommand* command = new AssignShortcutCommand(itemAction, QKeySequence::fromString(shortcutString, QKeySequence::NativeText));
     std::cout << "TEST SET SHORTCUT PUSH COMMAND" << std::endl;
@@ -473,8 +381,8 @@ bool ShortcutEditorModel::setData(const QModelIndex& index, const QVariant& valu
   if (role == Qt::EditRole && index.column() == static_cast<int>(Column::Shortcut)) {
     std::cout << "TEST SHORTCUT EDITOR MODEL SET DATA 2: " << value.toString().toStdString() << std::endl;
     QString keySequenceString = value.toString();
-    ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-    QAction* itemAction = item->action();
+    ShortcutEditorModelItem* item = itemFromIndex(index);
+    QAction* itemAction = item->data().action;
     if (itemAction) {
       if (keySequenceString == itemAction->shortcut().toString(QKeySequence::NativeText)) {
         return true;
@@ -487,8 +395,7 @@ bool ShortcutEditorModel::setData(const QModelIndex& index, const QVariant& valu
     }
 
     ShortcutEditorModelItem* foundItem = findShortcut(keySequenceString, ActionManager::getContext(itemAction));
-    const ShortcutEditorModelItem* currentItem = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-    if (!foundItem || currentItem == foundItem) {
+    if (!foundItem || item == foundItem) {
       setShortcut(item, keySequenceString, index);
       return true;
     }
@@ -496,8 +403,8 @@ bool ShortcutEditorModel::setData(const QModelIndex& index, const QVariant& valu
     QMessageBox messageBox;
     messageBox.setWindowTitle("Reassign shortcut?");
     messageBox.setIcon(QMessageBox::Warning);
-    const QString foundNameString = foundItem->data(static_cast<int>(Column::Name)).toString();
-    const QString foundShortcutString = foundItem->data(static_cast<int>(Column::Shortcut)).toString();
+    const QString foundNameString = foundItem->data().name;
+    const QString foundShortcutString = foundItem->data().action->shortcut().toString(QKeySequence::NativeText);
     const QString text = QLatin1String("Keyboard shortcut \"") + foundShortcutString + QLatin1String("\" is already assigned to \"") + foundNameString + QLatin1String("\".");
     messageBox.setText(text);
     messageBox.setInformativeText(tr("Are you sure you want to reassign this shortcut?"));
@@ -526,8 +433,8 @@ QMimeData* ShortcutEditorModel::mimeData(const QModelIndexList& indexes) const
   QStringList actionIds;
   for (const QModelIndex& index : indexes) {
     if (index.isValid()) {
-      const ShortcutEditorModelItem* currentItem = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-      QString actionId = QString::fromStdString(ActionManager::getId(currentItem->action()));
+      const ShortcutEditorModelItem* currentItem = itemFromIndex(index);
+      QString actionId = QString::fromStdString(ActionManager::getId(currentItem->data().action));
       actionIds.push_back(actionId);
     }
   }
@@ -583,9 +490,9 @@ bool ShortcutEditorModel::dropMimeData(const QMimeData* data,
 
 ShortcutEditorModelItem* ShortcutEditorModel::findShortcut(const QString& keySequenceString, const std::string& context)
 {
-  for (int i = 0; i < rootItem->childCount(); ++i) {
-    ShortcutEditorModelItem* contextLevel = rootItem->child(i);
-    if (contextLevel->data(static_cast<int>(Column::Name)).toString().toStdString() != context) {
+  for (int i = 0; i < rootItem()->childCount(); ++i) {
+    ShortcutEditorModelItem* contextLevel = rootItem()->child(i);
+    if (contextLevel->data().name.toStdString() != context) {
       continue;
     }
 
@@ -593,8 +500,8 @@ ShortcutEditorModelItem* ShortcutEditorModel::findShortcut(const QString& keySeq
       ShortcutEditorModelItem* categoryLevel = contextLevel->child(j);
       for (int k = 0; k < categoryLevel->childCount(); ++k) {
         ShortcutEditorModelItem* actionLevel = categoryLevel->child(k);
-        const QVariant actionLevelShortcut = actionLevel->data(static_cast<int>(Column::Shortcut));
-        if (keySequenceString == actionLevelShortcut.toString()) {
+        const QString actionLevelShortcut = actionLevel->data().action->shortcut().toString(QKeySequence::NativeText);
+        if (keySequenceString == actionLevelShortcut) {
           return actionLevel;
         }
       }
@@ -609,13 +516,13 @@ void ShortcutEditorModel::resetAll()
   std::cout << "TEST MODEL RESET ALL ADDRESS: " << reinterpret_cast<void*>(this) << std::endl;
 
   std::vector<QAction*> actions;
-  for (int i = 0; i < rootItem->childCount(); ++i) {
-    ShortcutEditorModelItem* contextLevel = rootItem->child(i);
+  for (int i = 0; i < rootItem()->childCount(); ++i) {
+    ShortcutEditorModelItem* contextLevel = rootItem()->child(i);
     for (int j = 0; j < contextLevel->childCount(); ++j) {
       ShortcutEditorModelItem* categoryLevel = contextLevel->child(j);
       for (int k = 0; k < categoryLevel->childCount(); ++k) {
         ShortcutEditorModelItem* actionLevel = categoryLevel->child(k);
-        QAction* action = actionLevel->action();
+        QAction* action = actionLevel->data().action;
         QKeySequence shortcut = action->shortcut();
         QKeySequence defaultShortcut = ActionManager::getDefaultShortcut(action);
         if (shortcut != defaultShortcut) {
@@ -637,13 +544,13 @@ void ShortcutEditorModel::resetAll()
 void ShortcutEditorModel::assignShortcut(const QString& actionId, const QKeySequence& keySequence)
 {
   std::cout << "TEST ASSIGN SHORTCUT ACTION ID: " << actionId.toStdString() << std::endl;
-  for (int i = 0; i < rootItem->childCount(); ++i) {
-    ShortcutEditorModelItem* contextLevel = rootItem->child(i);
+  for (int i = 0; i < rootItem()->childCount(); ++i) {
+    ShortcutEditorModelItem* contextLevel = rootItem()->child(i);
     for (int j = 0; j < contextLevel->childCount(); ++j) {
       ShortcutEditorModelItem* categoryLevel = contextLevel->child(j);
       for (int k = 0; k < categoryLevel->childCount(); ++k) {
         ShortcutEditorModelItem* actionLevel = categoryLevel->child(k);
-        QAction* action = actionLevel->action();
+        QAction* action = actionLevel->data().action;
         QString currentActionId = QString::fromStdString(ActionManager::getId(action));
         // std::cout << "TEST ASSIGN SHORTCUT CURRENT ACTION ID: " << currentActionId.toStdString() << std::endl;
         if (currentActionId == actionId) {
@@ -662,8 +569,7 @@ void ShortcutEditorModel::reset(const QModelIndexList& selectedItems)
   std::vector<QAction*> actions;
 
   for (const QModelIndex& selectedItem : selectedItems) {
-    ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(selectedItem.internalPointer());
-    QAction* action = item->action();
+    QAction* action = itemFromIndex(selectedItem)->data().action;
     QKeySequence shortcut = action->shortcut();
     QKeySequence defaultShortcut = ActionManager::getDefaultShortcut(action);
     if (shortcut != defaultShortcut) {
@@ -692,38 +598,37 @@ const QString& ShortcutEditorModel::hoverTooltipText()
 ShortcutEditorSortFilterProxyModel::ShortcutEditorSortFilterProxyModel(QObject* parent)
   : QSortFilterProxyModel(parent)
 {
+  _invalidateTimer.setSingleShot(true);
+  _invalidateTimer.setInterval(0);
+  connect(&_invalidateTimer, &QTimer::timeout, this, &ShortcutEditorSortFilterProxyModel::flushFilter);
 }
 
 bool ShortcutEditorSortFilterProxyModel::filterAcceptsRow(int sourceRow,
                                               const QModelIndex &sourceParent) const
 {
   QModelIndex index = sourceModel()->index(sourceRow, 0, sourceParent);
-  ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-  QAction* action = item->action();
+  const ShortcutEditorModelItem* item = static_cast<ShortcutEditorModel*>(sourceModel())->itemFromIndex(index);
+  if (!acceptsContext(item->data().context)) {
+    return false;
+  }
 
-  QString actionName = sourceModel()->data(index).toString();
+  return matches(item);
+}
 
-  if (!action) {
-    if (!_contexts.count(actionName.toStdString())) {
-      return false;
-    }
-    else {
-      // Note: Do we need to Handle the category line indices?
-    }
-  }
-  else {
-    const std::string context = ActionManager::getContext(action);
-    if (!_contexts.count(context)) {
-      return false;
-    }
-  }
+bool ShortcutEditorSortFilterProxyModel::acceptsContext(int context) const
+{
+  return context >= 0 && static_cast<size_t>(context) < _contextMask.size() && _contextMask[context];
+}
 
+bool ShortcutEditorSortFilterProxyModel::matches(const ShortcutEditorModelItem* item) const
+{
+  QAction* action = item->data().action;
   QString target;
   // std::cout << "TEST SEARCH TARGET SHORTCUT: " << _target << std::endl;
   switch (_target) {
     case SearchTarget::Shortcut:
       if (action) {
-        target = item->action()->shortcut().toString();
+        target = action->shortcut().toString();
       }
       break;
     case SearchTarget::DefaultShortcut:
@@ -742,29 +647,124 @@ bool ShortcutEditorSortFilterProxyModel::filterAcceptsRow(int sourceRow,
       break;
     case SearchTarget::Name:
     default:
-      target = actionName;
+      target = item->data().name;
       break;
   };
 
   return target.contains(filterRegularExpression());
 }
 
-void ShortcutEditorSortFilterProxyModel::updateContext(const std::string& context, bool checked)
+void ShortcutEditorSortFilterProxyModel::updateContext(int context, bool checked)
 {
-  if (checked) {
-    _contexts.insert(context);
-  }
-  else {
-    _contexts.erase(context);
+  if (context < 0) {
+    return;
   }
 
-  invalidateFilter();
+  if (static_cast<size_t>(context) >= _contextMask.size()) {
+    _contextMask.resize(context + 1, false);
+  }
+  _contextMask[context] = checked;
+  _invalidateTimer.start();
 }
 
 void ShortcutEditorSortFilterProxyModel::updateTarget(SearchTarget target)
 {
   _target = target;
+  _invalidateTimer.start();
+}
+
+void ShortcutEditorSortFilterProxyModel::flushFilter()
+{
+  _invalidateTimer.stop();
   invalidateFilter();
+  Q_EMIT filterUpdated();
+}
+
+ShortcutEditorListModel::ShortcutEditorListModel(ShortcutEditorModel* sourceModel, QObject* parent)
+  : QAbstractTableModel(parent)
+  , _sourceModel(sourceModel)
+{
+  // Only the visible rows are repainted, there is no need to find the changed ones.
+  connect(_sourceModel, &QAbstractItemModel::dataChanged, this, [this]() {
+    if (!_items.empty()) {
+      Q_EMIT dataChanged(index(0, 0), index(rowCount() - 1, columnCount() - 1));
+    }
+  });
+  connect(_sourceModel, &QAbstractItemModel::modelAboutToBeReset, this, [this]() {
+    beginResetModel();
+    _items.clear();
+  });
+  connect(_sourceModel, &QAbstractItemModel::modelReset, this, &ShortcutEditorListModel::endResetModel);
+}
+
+QVariant ShortcutEditorListModel::data(const QModelIndex& index, int role) const
+{
+  return _sourceModel->data(mapToSource(index), role);
+}
+
+Qt::ItemFlags ShortcutEditorListModel::flags(const QModelIndex& index) const
+{
+  // Shortcuts are dropped on the rows of the tree, where the drop target is known.
+  return _sourceModel->flags(mapToSource(index)) & ~Qt::ItemIsDropEnabled;
+}
+
+QVariant ShortcutEditorListModel::headerData(int section, Qt::Orientation orientation, int role) const
+{
+  return _sourceModel->headerData(section, orientation, role);
+}
+
+int ShortcutEditorListModel::rowCount(const QModelIndex& parent) const
+{
+  if (parent.isValid()) {
+    return 0;
+  }
+
+  return static_cast<int>(_items.size());
+}
+
+int ShortcutEditorListModel::columnCount(const QModelIndex& parent) const
+{
+  if (parent.isValid()) {
+    return 0;
+  }
+
+  return _sourceModel->columnCount();
+}
+
+bool ShortcutEditorListModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+  return _sourceModel->setData(mapToSource(index), value, role);
+}
+
+QMimeData* ShortcutEditorListModel::mimeData(const QModelIndexList& indexes) const
+{
+  QModelIndexList sourceIndexes;
+  for (const QModelIndex& index : indexes) {
+    sourceIndexes.push_back(mapToSource(index));
+  }
+
+  return _sourceModel->mimeData(sourceIndexes);
+}
+
+QStringList ShortcutEditorListModel::mimeTypes() const
+{
+  return _sourceModel->mimeTypes();
+}
+
+void ShortcutEditorListModel::setItems(std::vector<ShortcutEditorModelItem*> items)
+{
+  beginResetModel();
+  _items = std::move(items);
+  endResetModel();
+}
+
+QModelIndex ShortcutEditorListModel::mapToSource(const QModelIndex& index) const
+{
+  if (!index.isValid() || index.row() >= rowCount()) {
+    return QModelIndex();
+  }
+
+  return _sourceModel->indexFromItem(_items[index.row()], index.column());
 }
 
 ShortcutEditorWidget::ShortcutEditorWidget(QWidget* parent) :
@@ -776,8 +776,10 @@ ShortcutEditorWidget::ShortcutEditorWidget(QWidget* parent) :
 
   _model = new ShortcutEditorModel(this);
   createFilterModel();
+  _listModel = new ShortcutEditorListModel(_model, this);
   _delegate = new ShortcutEditorDelegate(this);
   createTreeView();
+  createListView();
 
   createKeyboardExpandLayout();
 
@@ -791,6 +793,7 @@ ShortcutEditorWidget::ShortcutEditorWidget(QWidget* parent) :
   // _keyboardWidget->setSizePolicy(QSizePolicy::Expanding, QSizePolicy::Expanding);
   connect(_view->model(), &QAbstractItemModel::dataChanged, _keyboardWidget, &KeyboardWidget::highlightShortcuts);
   connect(_view->selectionModel(), &QItemSelectionModel::selectionChanged, this, &ShortcutEditorWidget::setKeyboardContext);
+  connect(_listView->selectionModel(), &QItemSelectionModel::selectionChanged, this, &ShortcutEditorWidget::setKeyboardContext);
 
   createLayout();
 
@@ -811,6 +814,7 @@ void ShortcutEditorWidget::createLayout()
   layout->setContentsMargins(0, 0, 0, 0); // fill out to the entire widget area, no insets
   layout->addLayout(_searchLayout);
   layout->addWidget(_view);
+  layout->addWidget(_listView);
   layout->addLayout(_keyboardExpandLayout);
   layout->addWidget(_keyboardWidget);
   layout->addLayout(createButtonLayout());
@@ -825,6 +829,11 @@ void ShortcutEditorWidget::createFilterModel()
   _filterModel->setFilterCaseSensitivity(Qt::CaseInsensitive);
   _filterModel->setRecursiveFilteringEnabled(true);
   _filterModel->setDynamicSortFilter(true);
+  connect(_filterModel, &ShortcutEditorSortFilterProxyModel::filterUpdated, this, [this]() {
+    if (!_listView->isHidden()) {
+      updateFlatList();
+    }
+  });
 }
 
 void ShortcutEditorWidget::createSearchLayout()
@@ -884,6 +893,25 @@ void ShortcutEditorWidget::createTreeView()
   connect(_view, &QTreeView::expanded, this, &ShortcutEditorWidget::updateExpandStates);
 }
 
+void ShortcutEditorWidget::createListView()
+{
+  _listView = new QTreeView(this);
+  _listView->setModel(_listModel);
+  _listView->setItemDelegateForColumn(1, _delegate);
+  _listView->setRootIsDecorated(false);
+  _listView->setItemsExpandable(false);
+  // Rows are laid out without asking each of them for its height.
+  _listView->setUniformRowHeights(true);
+  _listView->setSizeAdjustPolicy(QAbstractScrollArea::AdjustToContents);
+  _listView->setAlternatingRowColors(true);
+  _listView->setSelectionBehavior(QTreeView::SelectRows);
+  _listView->setSelectionMode(QAbstractItemView::ExtendedSelection);
+  _listView->setDragDropMode(QAbstractItemView::DragOnly);
+  _listView->setAllColumnsShowFocus(true);
+  _listView->header()->resizeSection(0, 250);
+  _listView->hide();
+}
+
 void ShortcutEditorWidget::createTreeViewContextMenuActions()
 {
   QAction *expandAllAction = new QAction(tr("expand all"), this);
@@ -897,7 +925,7 @@ void ShortcutEditorWidget::createTreeViewContextMenuActions()
     for (const auto& selectedIndex : _view->selectionModel()->selectedIndexes()) {
       // TODO: From Qt 5.13
       // _view->expandRecursively(selectedIndex);
-      expandRecursively(selectedIndex, false);
+      expandRecursively(selectedIndex);
     }
   });
   _view->insertAction(nullptr, expandRecursivelyAction);
@@ -948,6 +976,11 @@ void ShortcutEditorWidget::setupTreeViewFiltering()
       _filterModel->setFilterRegularExpression(text);
     }
 
+    if (!_listView->isHidden()) {
+      updateFlatList();
+      return;
+    }
+
     if (text.isEmpty()) {
       _view->collapseAll();
     }
@@ -1005,18 +1038,18 @@ void ShortcutEditorWidget::setKeyboardContext(const QItemSelection& selected, co
     return _keyboardWidget->setActions({});
   }
 
-  QModelIndex index = _filterModel->mapToSource(selected.indexes()[0]);
-  ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-  QAction* selectedAction = item->action();
+  QModelIndex index = mapToSource(selected.indexes()[0]);
+  ShortcutEditorModelItem* item = _model->itemFromIndex(index);
+  QAction* selectedAction = item->data().action;
   QString context;
   if (selectedAction) {
     context = QString::fromStdString(ActionManager::getContext(selectedAction));
   }
   else if (!item->parentItem()->parentItem()) {
-    context = item->data(static_cast<int>(Column::Name)).toString();
+    context = item->data().name;
   }
   else if (!item->parentItem()->parentItem()->parentItem()) {
-    context = item->parentItem()->data(static_cast<int>(Column::Name)).toString();
+    context = item->parentItem()->data().name;
   }
 
   std::vector<QAction*> actions;
@@ -1081,15 +1114,17 @@ void ShortcutEditorWidget::setActions()
     }
     contextAction->setChecked(sSearchToolButtonState._contextActionsState[stdContextName]);
     _contextActions.push_back(contextAction);
-    _filterModel->updateContext(contextAction->text().toStdString(), true);
-    connect(contextAction, &QAction::triggered, [this, contextAction](const bool triggered) {
-      if (!triggered) {
+    const int contextIndex = ActionManager::getContextIndex(stdContextName);
+    _filterModel->updateContext(contextIndex, contextAction->isChecked());
+    // Also toggled when "All" checks every context, which refilters once.
+    connect(contextAction, &QAction::toggled, [this, contextIndex](const bool checked) {
+      if (!checked) {
         _allContextsAction->setChecked(false);
       }
       if (std::all_of(_contextActions.cbegin(), _contextActions.cend(), [](QAction* action){ return action->isChecked(); })) {
         _allContextsAction->setChecked(true);
       }
-      _filterModel->updateContext(contextAction->text().toStdString(), triggered);
+      _filterModel->updateContext(contextIndex, checked);
     });
   }
 
@@ -1144,16 +1179,26 @@ void ShortcutEditorWidget::setActions()
   _matchRegularExpressionAction->setChecked(sSearchToolButtonState._matchGroupName == _matchRegularExpressionAction->text());
   matchActionGroup->addAction(_matchRegularExpressionAction);
 
+  _searchToolButtonMenu->addSection("View");
+
+  _flatListAction = _searchToolButtonMenu->addAction(tr("Flat list"));
+  _flatListAction->setCheckable(true);
+  _flatListAction->setChecked(sSearchToolButtonState._flatList);
+  _flatListAction->setToolTip(tr("Shows the matching actions of all contexts as one list"));
+  connect(_flatListAction, &QAction::toggled, this, &ShortcutEditorWidget::setFlatList);
+
+  _filterModel->flushFilter();
   restoreExpandState();
+  setFlatList(_flatListAction->isChecked());
 }
 
 void ShortcutEditorWidget::reset()
 {
-  QModelIndexList selectedItems = _view->selectionModel()->selectedIndexes();
+  QModelIndexList selectedItems = currentView()->selectionModel()->selectedIndexes();
 
   QModelIndexList sourceSelectedItems;
   for (const QModelIndex& selectedItem : selectedItems) {
-    sourceSelectedItems.push_back(_filterModel->mapToSource(selectedItem));
+    sourceSelectedItems.push_back(mapToSource(selectedItem));
   }
 
   _model->reset(sourceSelectedItems);
@@ -1165,24 +1210,92 @@ void ShortcutEditorWidget::resetAll()
   _model->resetAll();
 }
 
+void ShortcutEditorWidget::setFlatList(bool flatList)
+{
+  _view->setVisible(!flatList);
+  _listView->setVisible(flatList);
+  if (flatList) {
+    updateFlatList();
+    return;
+  }
+
+  _listModel->setItems({});
+  if (!_search->text().isEmpty()) {
+    _view->expandAll();
+  }
+}
+
+void ShortcutEditorWidget::updateFlatList()
+{
+  std::vector<ShortcutEditorModelItem*> items;
+  const ShortcutEditorModelItem* rootItem = _model->itemFromIndex(QModelIndex());
+  for (int i = 0; i < rootItem->childCount(); ++i) {
+    const ShortcutEditorModelItem* contextLevel = rootItem->child(i);
+    if (!_filterModel->acceptsContext(contextLevel->data().context)) {
+      continue;
+    }
+
+    for (int j = 0; j < contextLevel->childCount(); ++j) {
+      const ShortcutEditorModelItem* categoryLevel = contextLevel->child(j);
+      for (int k = 0; k < categoryLevel->childCount(); ++k) {
+        ShortcutEditorModelItem* actionLevel = categoryLevel->child(k);
+        if (_filterModel->matches(actionLevel)) {
+          items.push_back(actionLevel);
+        }
+      }
+    }
+  }
+
+  _listModel->setItems(std::move(items));
+}
+
+QTreeView* ShortcutEditorWidget::currentView() const
+{
+  return _listView->isHidden() ? _view : _listView;
+}
+
+QModelIndex ShortcutEditorWidget::mapToSource(const QModelIndex& index) const
+{
+  if (index.model() == _listModel) {
+    return _listModel->mapToSource(index);
+  }
+
+  return _filterModel->mapToSource(index);
+}
+
 void ShortcutEditorWidget::updateExpandStates(const QModelIndex& index)
 {
   QModelIndex sourceIndex = _filterModel->mapToSource(index);
-  ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(sourceIndex.internalPointer());
-  sShortcutEditorCurrentExpandState[item->id().toStdString()] = _view->isExpanded(index);
+  ShortcutEditorModelItem* item = _model->itemFromIndex(sourceIndex);
+  ShortcutEditorExpandState::setExpanded(item->data().id, _view->isExpanded(index));
 }
 
 void ShortcutEditorWidget::restoreExpandState()
 {
+  // With a relayout pending, as after collapseAll(), expanding only records
+  // the index, and the view is laid out once for all of them.
+  _view->setUpdatesEnabled(false);
   _view->blockSignals(true);
-  for (int i = 0; i < _model->rowCount(); i++) {
-    const QModelIndex child = _filterModel->index(i, 0);
-    expandRecursively(child, true);
+  _view->collapseAll();
+  const ShortcutEditorModelItem* rootItem = _model->itemFromIndex(QModelIndex());
+  for (int i = 0; i < rootItem->childCount(); ++i) {
+    ShortcutEditorModelItem* contextLevel = rootItem->child(i);
+    if (ShortcutEditorExpandState::isExpanded(contextLevel->data().id)) {
+      _view->expand(_filterModel->mapFromSource(_model->indexFromItem(contextLevel)));
+    }
+
+    for (int j = 0; j < contextLevel->childCount(); ++j) {
+      ShortcutEditorModelItem* categoryLevel = contextLevel->child(j);
+      if (ShortcutEditorExpandState::isExpanded(categoryLevel->data().id)) {
+        _view->expand(_filterModel->mapFromSource(_model->indexFromItem(categoryLevel)));
+      }
+    }
   }
   _view->blockSignals(false);
+  _view->setUpdatesEnabled(true);
 }
 
-void ShortcutEditorWidget::expandRecursively(const QModelIndex& index, bool fromExpandState)
+void ShortcutEditorWidget::expandRecursively(const QModelIndex& index)
 {
   if (!index.isValid()) {
     return;
@@ -1190,17 +1303,10 @@ void ShortcutEditorWidget::expandRecursively(const QModelIndex& index, bool from
 
   for (int i = 0; i < index.model()->rowCount(index); i++) {
     const QModelIndex &child = index.model()->index(i, 0, index);
-    expandRecursively(child, fromExpandState);
+    expandRecursively(child);
   }
 
-  if (fromExpandState) {
-    const auto& nonProxyIndex = _filterModel->mapToSource(index);
-    ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(nonProxyIndex.internalPointer());
-    if (sShortcutEditorCurrentExpandState[item->id().toStdString()]) {
-      _view->expand(index);
-    }
-  }
-  else if (!_view->isExpanded(index)) {
+  if (!_view->isExpanded(index)) {
     _view->expand(index);
   }
 }
@@ -1210,6 +1316,7 @@ void ShortcutEditorWidget::updateSearchToolButtonState()
   sSearchToolButtonState._allContexts = _allContextsAction->isChecked();
   sSearchToolButtonState._defaultShortcutChecked = _defaultShortcutAction->isChecked();
   sSearchToolButtonState._customShortcutChecked = _customShortcutAction->isChecked();
+  sSearchToolButtonState._flatList = _flatListAction->isChecked();
 
   for (const auto& contextAction : _contextActions) {
     sSearchToolButtonState._contextActionsState[contextAction->text().toStdString()] = contextAction->isChecked();
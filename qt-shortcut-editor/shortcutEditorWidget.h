@@ -1,15 +1,19 @@
 #ifndef SHORTCUTEDITORWIDGET_H
 #define SHORTCUTEDITORWIDGET_H
 
+#include "actionTreeModel.h"
+
+#include <QAbstractTableModel>
 #include <QSortFilterProxyModel>
 #include <QString>
+#include <QStringList>
 #include <QStyledItemDelegate>
+#include <QTimer>
 #include <QUndoCommand>
 #include <QWidget>
 
 #include <string>
-#include <unordered_map>
-#include <unordered_set>
+#include <vector>
 
 class QAction;
 class QCheckBox;
@@ -30,7 +34,22 @@ using CategoryActionsMap = std::map<QString, std::vector<QAction*>>;
 // List of categories for all contexts
 using ActionsMap = std::map<QString, CategoryActionsMap>;
 
-using ShortcutEditorExpandState = std::unordered_map<std::string, bool>;
+// Which context and category nodes are expanded. It outlives the editors and
+// is saved with the shortcuts. Node keys are interned to small ids once, so
+// the state itself is a bitset indexed by them.
+class ShortcutEditorExpandState
+{
+  ShortcutEditorExpandState() = delete;
+  ~ShortcutEditorExpandState() = delete;
+
+public:
+  static int intern(const QString& key);
+  static bool isExpanded(int id);
+  static void setExpanded(int id, bool expanded);
+
+  static QStringList expandedKeys();
+  static void setExpandedKeys(const QStringList& keys);
+};
 
 enum class Column : uint8_t {
   Name,
@@ -51,6 +70,7 @@ struct SearchToolButtonState
   bool _allContexts;
   bool _defaultShortcutChecked;
   bool _customShortcutChecked;
+  bool _flatList;
   std::map<std::string, bool> _contextActionsState;
 };
 
@@ -75,33 +95,21 @@ private:
   std::vector<ShortcutCommandData> _data;
 };
 
-class ShortcutEditorModelItem
+struct ShortcutEditorItemData
 {
-public:
-    explicit ShortcutEditorModelItem(const std::vector<QVariant>& data,
-                                   const QString& id,
-                                   ShortcutEditorModelItem* parentItem = nullptr);
-    ~ShortcutEditorModelItem();
-
-    void appendChild(ShortcutEditorModelItem* child);
-
-    ShortcutEditorModelItem* child(int row);
-    int childCount() const;
-    int columnCount() const;
-    QVariant data(int column) const;
-    int row() const;
-    ShortcutEditorModelItem* parentItem();
-    const QString& id() const;
-    QAction* action() const;
-
-private:
-    std::vector<ShortcutEditorModelItem*> _childItems;
-    std::vector<QVariant> _itemData;
-    ShortcutEditorModelItem* _parentItem;
-    QString _id;
+  QString name;
+  // Null for the context and category rows.
+  QAction* action = nullptr;
+  // Of the node in ShortcutEditorExpandState, -1 for the action rows.
+  int id = -1;
+  // The ActionManager context index the row is filtered by. It is -1 for the
+  // category rows, which are only shown for their matching actions.
+  int context = -1;
 };
 
-class ShortcutEditorModel : public QAbstractItemModel
+using ShortcutEditorModelItem = ActionTreeItem<ShortcutEditorItemData>;
+
+class ShortcutEditorModel : public ActionTreeModel<ShortcutEditorItemData>
 {
   Q_OBJECT
 
@@ -112,10 +120,6 @@ public:
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   Qt::ItemFlags flags(const QModelIndex& index) const override;
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
-  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
-  QModelIndex parent(const QModelIndex& index) const override;
-  int rowCount(const QModelIndex& index = QModelIndex()) const override;
-  int columnCount(const QModelIndex& index = QModelIndex()) const override;
 
   bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
 
@@ -146,7 +150,6 @@ private:
   void setShortcut(ShortcutEditorModelItem* item, const QString& shortcutString, const QModelIndex& index);
   void setupModelData(ShortcutEditorModelItem* parent);
 
-  ShortcutEditorModelItem* rootItem;
   ActionsMap _actionsMap;
   QString _hoverTooltip;
   QUndoStack* _undoStack;
@@ -159,15 +162,57 @@ class ShortcutEditorSortFilterProxyModel : public QSortFilterProxyModel
 public:
   ShortcutEditorSortFilterProxyModel(QObject *parent = 0);
 
+  bool acceptsContext(int context) const;
+  // Whether the search target of the item matches the filter.
+  bool matches(const ShortcutEditorModelItem* item) const;
+
 public Q_SLOTS:
-  void updateContext(const std::string& context, bool checked);
+  // Changes are applied together in one refilter when control returns to the
+  // event loop, e.g. after all the contexts are checked.
+  void updateContext(int context, bool checked);
   void updateTarget(SearchTarget target);
+  // Applies the pending changes now.
+  void flushFilter();
+
+Q_SIGNALS:
+  void filterUpdated();
 
 private:
   bool filterAcceptsRow(int sourceRow, const QModelIndex &sourceParent) const override;
 
-  std::unordered_set<std::string> _contexts;
+  // Indexed by ActionManager context index.
+  std::vector<bool> _contextMask;
   SearchTarget _target;
+  QTimer _invalidateTimer;
+};
+
+// The matching actions as a flat list, for searching across all contexts
+// without the row bookkeeping of an expanded tree. The rows are action items
+// of the source model, and data, edits and drags go through it.
+class ShortcutEditorListModel : public QAbstractTableModel
+{
+  Q_OBJECT
+
+public:
+  explicit ShortcutEditorListModel(ShortcutEditorModel* sourceModel, QObject* parent = nullptr);
+
+  QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+  Qt::ItemFlags flags(const QModelIndex& index) const override;
+  QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
+  int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+  int columnCount(const QModelIndex& parent = QModelIndex()) const override;
+
+  bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+  QMimeData* mimeData(const QModelIndexList& indexes) const override;
+  QStringList mimeTypes() const override;
+
+  void setItems(std::vector<ShortcutEditorModelItem*> items);
+  QModelIndex mapToSource(const QModelIndex& index) const;
+
+private:
+  ShortcutEditorModel* _sourceModel;
+  std::vector<ShortcutEditorModelItem*> _items;
 };
 
 class ShortcutEditorDelegate : public QStyledItemDelegate
@@ -210,7 +255,7 @@ public Q_SLOTS:
   void reset();
   void resetAll();
 
-  void expandRecursively(const QModelIndex& index, bool fromExpandState = false);
+  void expandRecursively(const QModelIndex& index);
   void updateExpandStates(const QModelIndex&);
 
 private Q_SLOTS:
@@ -219,12 +264,18 @@ private Q_SLOTS:
 private:
   void restoreExpandState();
 
+  void setFlatList(bool flatList);
+  void updateFlatList();
+  QTreeView* currentView() const;
+  QModelIndex mapToSource(const QModelIndex& index) const;
+
   void updateSearchToolButtonState();
 
   void createLayout();
   void createSearchLayout();
   void createFilterModel();
   void createTreeView();
+  void createListView();
   void createTreeViewContextMenuActions();
   void setupTreeViewFiltering();
   void createKeyboardExpandLayout();
@@ -233,11 +284,13 @@ private:
   ShortcutEditorDelegate* _delegate;
   ShortcutEditorModel* _model;
   ShortcutEditorSortFilterProxyModel* _filterModel;
+  ShortcutEditorListModel* _listModel;
   QHBoxLayout* _searchLayout;
   QToolButton* _searchToolButton;
   QMenu* _searchToolButtonMenu;
   QLineEdit* _search;
   QTreeView* _view;
+  QTreeView* _listView;
   QHBoxLayout* _keyboardExpandLayout;
   QToolButton* _keyboardExpandToolButton;
   KeyboardWidget* _keyboardWidget;
@@ -256,6 +309,7 @@ private:
   QAction* _matchEndsWithAction;
   QAction* _matchWildcardAction;
   QAction* _matchRegularExpressionAction;
+  QAction* _flatListAction;
 
 };
 
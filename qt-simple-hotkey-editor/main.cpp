@@ -60,7 +60,7 @@ int main(int argc, char *argv[])
     hotkeys.insert({contextName, categoryHotkeys});
   }
 
-  hotkeyEditorWidget->setHotkeys(hotkeys);
+  hotkeyEditorWidget->setHotkeys(std::move(hotkeys));
   hotkeyEditorWidget->show();
   return app.exec();
 }
@@ -11,87 +11,6 @@
 #include <QTreeView>
 #include <QVBoxLayout>
 
-ShortcutEditorModelItem::ShortcutEditorModelItem(const std::vector<QVariant> &data, ShortcutEditorModelItem *parent)
-    : _itemData(data)
-    , _parentItem(parent)
-{
-}
-
-ShortcutEditorModelItem::~ShortcutEditorModelItem()
-{
-    qDeleteAll(_childItems);
-}
-
-void ShortcutEditorModelItem::appendChild(ShortcutEditorModelItem *item)
-{
-    _childItems.push_back(item);
-}
-
-ShortcutEditorModelItem* ShortcutEditorModelItem::child(int row)
-{
-    if (row < 0 || static_cast<size_t>(row) >= _childItems.size()) {
-        return nullptr;
-    }
-  
-    return _childItems.at(row);
-}
-
-int ShortcutEditorModelItem::childCount() const
-{
-    return _childItems.size();
-}
-
-int ShortcutEditorModelItem::row() const
-{
-    if (_parentItem) {
-       auto it = std::find(_parentItem->_childItems.cbegin(), _parentItem->_childItems.cend(), const_cast<ShortcutEditorModelItem*>(this));
-       if (it != _parentItem->_childItems.cend()) {
-           return std::distance(_parentItem->_childItems.cbegin(), it);
-       }
-       else {
-           return -1;
-       }
-    }
-  
-    return 0;
-}
-
-int ShortcutEditorModelItem::columnCount() const
-{
-    return _itemData.size();
-}
-
-QVariant ShortcutEditorModelItem::data(int column) const
-{
-    if (column < 0 || static_cast<size_t>(column) >= _itemData.size()) {
-        return QVariant();
-    }
-  
-    QVariant columnVariant = _itemData.at(column);
-    if (column != static_cast<int>(Column::Shortcut) || columnVariant.canConvert<QString>()) {
-        return columnVariant;
-    }
-  
-    QAction *action = static_cast<QAction *>(columnVariant.value<void *>());
-    if (!action) {
-        return QVariant();
-    }
-    QKeySequence keySequence = action->shortcut();
-    QString keySequenceString = keySequence.toString(QKeySequence::NativeText);
-    return keySequenceString;
-}
-
-ShortcutEditorModelItem *ShortcutEditorModelItem::parentItem()
-{
-    return _parentItem;
-}
-
-QAction *ShortcutEditorModelItem::action() const
-{
-    QVariant actionVariant = _itemData.at(static_cast<int>(Column::Shortcut));
-    return static_cast<QAction*>(actionVariant.value<void *>());
-}
-
 ShortcutEditorDelegate::ShortcutEditorDelegate(QObject* parent)
   : QStyledItemDelegate(parent)
 {
@@ -151,88 +70,17 @@ void ShortcutEditorDelegate::updateEditorGeometry(QWidget* editor,
 }
 
 ShortcutEditorModel::ShortcutEditorModel(QObject* parent)
-  : QAbstractItemModel(parent)
+  : ActionTreeModel(static_cast<int>(Column::Shortcut) + 1, parent)
 {
-    rootItem = new ShortcutEditorModelItem({tr("Name"), tr("Shortcut")});
-}
-
-ShortcutEditorModel::~ShortcutEditorModel()
-{
-    delete rootItem;
 }
 
 void ShortcutEditorModel::setActions()
 {
     beginResetModel();
-    setupModelData(rootItem);
+    setupModelData(rootItem());
     endResetModel();
 }
 
-QModelIndex ShortcutEditorModel::index(int row, int column, const QModelIndex& parent) const
-{
-  if (!hasIndex(row, column, parent)) {
-      return QModelIndex();
-  }
-
-  ShortcutEditorModelItem* parentItem;
-
-  if (!parent.isValid()) {
-      parentItem = rootItem;
-  }
-  else {
-      parentItem = static_cast<ShortcutEditorModelItem*>(parent.internalPointer());
-  }
-
-  ShortcutEditorModelItem* childItem = parentItem->child(row);
-  if (childItem) {
-      return createIndex(row, column, childItem);
-  }
-
-  return QModelIndex();
-}
-
-QModelIndex ShortcutEditorModel::parent(const QModelIndex& index) const
-{
-  if (!index.isValid()) {
-      return QModelIndex();
-  }
-
-  ShortcutEditorModelItem* childItem = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-  ShortcutEditorModelItem* parentItem = childItem->parentItem();
-
-  if (parentItem == rootItem) {
-      return QModelIndex();
-  }
-
-  return createIndex(parentItem->row(), 0, parentItem);
-}
-
-int ShortcutEditorModel::rowCount(const QModelIndex& parent) const
-{
-  ShortcutEditorModelItem* parentItem;
-  if (parent.column() > 0) {
-      return 0;
-  }
-
-  if (!parent.isValid()) {
-      parentItem = rootItem;
-  }
-  else {
-      parentItem = static_cast<ShortcutEditorModelItem*>(parent.internalPointer());
-  }
-
-  return parentItem->childCount();
-}
-
-int ShortcutEditorModel::columnCount(const QModelIndex& parent) const
-{
-  if (parent.isValid()) {
-      return static_cast<ShortcutEditorModelItem*>(parent.internalPointer())->columnCount();
-  }
-
-  return rootItem->columnCount();
-}
-
 QVariant ShortcutEditorModel::data(const QModelIndex& index, int role) const
 {
   if (!index.isValid()) {
@@ -243,8 +91,18 @@ QVariant ShortcutEditorModel::data(const QModelIndex& index, int role) const
       return QVariant();
   }
 
-  ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-  return item->data(index.column());
+  const ShortcutEditorItemData& itemData = itemFromIndex(index)->data();
+  switch (static_cast<Column>(index.column())) {
+    case Column::Name:
+      return itemData.name;
+    case Column::Shortcut:
+      if (!itemData.action) {
+          return QVariant();
+      }
+      return itemData.action->shortcut().toString(QKeySequence::NativeText);
+  }
+
+  return QVariant();
 }
 
 Qt::ItemFlags ShortcutEditorModel::flags(const QModelIndex& index) const
@@ -262,8 +120,15 @@ Qt::ItemFlags ShortcutEditorModel::flags(const QModelIndex& index) const
 
 QVariant ShortcutEditorModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
-      return rootItem->data(section);
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+      return QVariant();
+  }
+
+  switch (static_cast<Column>(section)) {
+    case Column::Name:
+      return tr("Name");
+    case Column::Shortcut:
+      return tr("Shortcut");
   }
 
   return QVariant();
@@ -306,24 +171,19 @@ void ShortcutEditorModel::setupModelData(ShortcutEditorModelItem* parent)
     }
   }
 
-  QAction* nullAction = nullptr;
-  const QString contextIdPrefix = "root";
+  parent->clear();
   // Go through each context, one context - many categories each iteration
   for (const auto& contextLevel : _actionsMap) {
     // TODO: make it "tr()".
-    ShortcutEditorModelItem* contextLevelItem = new ShortcutEditorModelItem({contextLevel.first, QVariant::fromValue(nullAction)}, parent);
-    parent->appendChild(contextLevelItem);
+    ShortcutEditorModelItem* contextLevelItem = parent->appendChild({contextLevel.first});
     // Go through each category, one category - many actions each iteration
     for (const auto& categoryLevel : contextLevel.second) {
-      ShortcutEditorModelItem* categoryLevelItem = new ShortcutEditorModelItem({categoryLevel.first, QVariant::fromValue(nullAction)}, contextLevelItem);
-      contextLevelItem->appendChild(categoryLevelItem);
+      ShortcutEditorModelItem* categoryLevelItem = contextLevelItem->appendChild({categoryLevel.first});
       for (const auto& action : categoryLevel.second) {
-        QString name = action->text();
-        if (name.isEmpty() || action == nullptr) {
+        if (action == nullptr || action->text().isEmpty()) {
           continue;
         }
-        ShortcutEditorModelItem* actionLevelItem = new ShortcutEditorModelItem({name, QVariant::fromValue(reinterpret_cast<void*>(action))}, categoryLevelItem);
-        categoryLevelItem->appendChild(actionLevelItem);
+        categoryLevelItem->appendChild({action->text(), action});
       }
     }
   }
@@ -333,8 +193,7 @@ bool ShortcutEditorModel::setData(const QModelIndex& index, const QVariant& valu
 {
   if (role == Qt::EditRole && index.column() == static_cast<int>(Column::Shortcut)) {
       QString keySequenceString = value.toString();
-      ShortcutEditorModelItem* item = static_cast<ShortcutEditorModelItem*>(index.internalPointer());
-      QAction* itemAction = item->action();
+      QAction* itemAction = itemFromIndex(index)->data().action;
       if (itemAction) {
           if (keySequenceString == itemAction->shortcut().toString(QKeySequence::NativeText)) {
             return true;
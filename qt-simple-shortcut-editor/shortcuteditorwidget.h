@@ -1,6 +1,8 @@
 #ifndef SHORTCUTEDITORWIDGET_H
 #define SHORTCUTEDITORWIDGET_H
 
+#include "actionTreeModel.h"
+
 #include <QString>
 #include <QStyledItemDelegate>
 #include <QWidget>
@@ -26,44 +28,26 @@ enum class Column : uint8_t {
   Shortcut
 };
 
-class ShortcutEditorModelItem
+struct ShortcutEditorItemData
 {
-public:
-    explicit ShortcutEditorModelItem(const std::vector<QVariant>& data,
-                                     ShortcutEditorModelItem* parentItem = nullptr);
-    ~ShortcutEditorModelItem();
-
-    void appendChild(ShortcutEditorModelItem* child);
-
-    ShortcutEditorModelItem* child(int row);
-    int childCount() const;
-    int columnCount() const;
-    QVariant data(int column) const;
-    int row() const;
-    ShortcutEditorModelItem* parentItem();
-    QAction* action() const;
-
-private:
-    std::vector<ShortcutEditorModelItem*> _childItems;
-    std::vector<QVariant> _itemData;
-    ShortcutEditorModelItem* _parentItem;
+  QString name;
+  // Null for the context and category rows.
+  QAction* action = nullptr;
 };
 
-class ShortcutEditorModel : public QAbstractItemModel
+using ShortcutEditorModelItem = ActionTreeItem<ShortcutEditorItemData>;
+
+class ShortcutEditorModel : public ActionTreeModel<ShortcutEditorItemData>
 {
   Q_OBJECT
 
 public:
   explicit ShortcutEditorModel(QObject* parent = nullptr);
-  ~ShortcutEditorModel() override;
+  ~ShortcutEditorModel() override = default;
 
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   Qt::ItemFlags flags(const QModelIndex& index) const override;
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
-  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
-  QModelIndex parent(const QModelIndex& index) const override;
-  int rowCount(const QModelIndex& index = QModelIndex()) const override;
-  int columnCount(const QModelIndex& index = QModelIndex()) const override;
 
   bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
 
@@ -72,7 +56,6 @@ public:
 private:
   void setupModelData(ShortcutEditorModelItem* parent);
 
-  ShortcutEditorModelItem* rootItem;
   ActionsMap _actionsMap;
 };
 
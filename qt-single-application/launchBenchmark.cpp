@@ -0,0 +1,112 @@
+#include "openRequestServer.h"
+
+#include <QCoreApplication>
+#include <QDir>
+#include <QElapsedTimer>
+#include <QLocalSocket>
+#include <QProcess>
+#include <QThread>
+
+#include <algorithm>
+#include <cstdlib>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Of main.cpp.
+static const char* kApplicationId = "SingleApplicationExample";
+
+// Usage: LaunchBenchmark [launches] [burst]
+//
+// Times cold starts of SingleApplication that quit once their window is
+// shown. Then starts a primary instance and times launches that hand their
+// arguments to it, one at a time and then as a burst, and prints how many
+// batches the primary opened the burst in. Set QT_QPA_PLATFORM=offscreen to
+// run it without a display.
+static double Median(std::vector<qint64> nanoseconds)
+{
+  std::sort(nanoseconds.begin(), nanoseconds.end());
+  return nanoseconds.empty() ? 0.0 : nanoseconds[nanoseconds.size() / 2] / 1e6;
+}
+
+static qint64 Launch(const QString& program, const QStringList& arguments)
+{
+  QElapsedTimer timer;
+  timer.start();
+  QProcess process;
+  process.start(program, arguments);
+  process.waitForFinished(-1);
+  return timer.nsecsElapsed();
+}
+
+static bool WaitForPrimary(int timeout)
+{
+  QElapsedTimer timer;
+  timer.start();
+  while (timer.elapsed() < timeout) {
+    QLocalSocket socket;
+    socket.connectToServer(OpenRequestServer::serverName(kApplicationId));
+    if (socket.waitForConnected(100)) {
+      return true;
+    }
+    QThread::msleep(10);
+  }
+  return false;
+}
+
+int main(int argc, char *argv[])
+{
+  QCoreApplication app(argc, argv);
+
+  const int launches = argc > 1 ? std::atoi(argv[1]) : 20;
+  const int burst = argc > 2 ? std::atoi(argv[2]) : 50;
+  const QString program = QDir(QCoreApplication::applicationDirPath()).filePath("SingleApplication");
+
+  std::vector<qint64> coldStarts;
+  for (int launch = 0; launch < launches; ++launch) {
+    coldStarts.push_back(Launch(program, {"--exit-when-ready"}));
+  }
+  std::cout << "cold start:    " << Median(coldStarts) << " ms median" << std::endl;
+
+  QProcess primary;
+  primary.start(program);
+  if (!WaitForPrimary(10000)) {
+    std::cerr << "The primary instance did not start listening." << std::endl;
+    primary.kill();
+    primary.waitForFinished();
+    return 1;
+  }
+
+  std::vector<qint64> secondLaunches;
+  for (int launch = 0; launch < launches; ++launch) {
+    secondLaunches.push_back(Launch(program, {"file" + QString::number(launch)}));
+  }
+  std::cout << "second launch: " << Median(secondLaunches) << " ms median" << std::endl;
+
+  // Only count the batches of the burst.
+  primary.waitForReadyRead(200);
+  primary.readAllStandardOutput();
+
+  QElapsedTimer timer;
+  timer.start();
+  std::vector<std::unique_ptr<QProcess>> processes;
+  for (int launch = 0; launch < burst; ++launch) {
+    processes.push_back(std::make_unique<QProcess>());
+    processes.back()->start(program, {"burst" + QString::number(launch)});
+  }
+  for (const std::unique_ptr<QProcess>& process : processes) {
+    process->waitForFinished(-1);
+  }
+  const qint64 burstTime = timer.nsecsElapsed();
+
+  // Longer than the coalescing interval of the primary.
+  QThread::msleep(200);
+  primary.waitForReadyRead(200);
+  const int batches = static_cast<int>(primary.readAllStandardOutput().count("batch:"));
+  std::cout << "burst:         " << burst << " launches in " << burstTime / 1e6 << " ms, "
+            << batches << " batches" << std::endl;
+
+  primary.kill();
+  primary.waitForFinished();
+  return 0;
+}
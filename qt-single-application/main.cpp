@@ -1,7 +1,74 @@
+#include "openRequestServer.h"
+
 #include <QtSingleApplication/qtsingleapplication.h>
 
+#include <QDir>
+#include <QPlainTextEdit>
+#include <QTimer>
+
+#include <iostream>
+
+static const char* kApplicationId = "SingleApplicationExample";
+// Quits once the window is shown, for timing a cold start.
+static const char* kExitWhenReadyOption = "--exit-when-ready";
+
 int main(int argc, char **argv)
 {
-  QtSingleApplication app(argc, argv);
+  {
+    // Handing the arguments to a running instance only needs the event
+    // dispatcher of a core application, not the widgets and the platform
+    // plugin of QtSingleApplication.
+    QCoreApplication coreApplication(argc, argv);
+    OpenRequest request;
+    request.workingDirectory = QDir::currentPath();
+    request.arguments = QCoreApplication::arguments().mid(1);
+    if (OpenRequestServer::forward(kApplicationId, request)) {
+      return 0;
+    }
+  }
+
+  QtSingleApplication app(kApplicationId, argc, argv);
+  OpenRequest request;
+  request.workingDirectory = QDir::currentPath();
+  request.arguments = QCoreApplication::arguments().mid(1);
+
+  // Another instance started at the same time and won.
+  if (app.isRunning()) {
+    return app.sendMessage(OpenRequestServer::encodeMessage(request)) ? 0 : 1;
+  }
+
+  QPlainTextEdit window;
+  window.setReadOnly(true);
+  window.resize(640, 480);
+  app.setActivationWindow(&window);
+
+  OpenRequestServer openRequestServer(kApplicationId);
+  QObject::connect(&app, &QtSingleApplication::messageReceived, &openRequestServer, [&openRequestServer](const QString& message) {
+    openRequestServer.addRequest(OpenRequestServer::decodeMessage(message));
+  });
+  QObject::connect(&openRequestServer, &OpenRequestServer::openRequested, &window, [&app, &window](const std::vector<OpenRequest>& requests) {
+    int argumentCount = 0;
+    for (const OpenRequest& openRequest : requests) {
+      for (const QString& argument : openRequest.arguments) {
+        window.appendPlainText(QDir(openRequest.workingDirectory).absoluteFilePath(argument));
+      }
+      argumentCount += static_cast<int>(openRequest.arguments.size());
+    }
+    std::cout << "batch: " << requests.size() << " requests, " << argumentCount << " arguments" << std::endl;
+    app.activateWindow();
+  });
+  if (!openRequestServer.listen()) {
+    std::cerr << "Could not listen for open requests, later launches start slower." << std::endl;
+  }
+
+  for (const QString& argument : request.arguments) {
+    window.appendPlainText(QDir(request.workingDirectory).absoluteFilePath(argument));
+  }
+  window.show();
+
+  if (request.arguments.contains(kExitWhenReadyOption)) {
+    QTimer::singleShot(0, &app, &QCoreApplication::quit);
+  }
+
   return app.exec();
 }
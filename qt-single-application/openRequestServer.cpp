@@ -0,0 +1,203 @@
+#include "openRequestServer.h"
+
+#include <QLocalServer>
+#include <QLocalSocket>
+#include <QtEndian>
+
+// Larger frames are taken for a broken or foreign client.
+static constexpr quint32 kMaximumFrameSize = 1024 * 1024;
+
+static void AppendUint32(QByteArray& frame, quint32 value)
+{
+  char bytes[sizeof(quint32)];
+  qToBigEndian(value, bytes);
+  frame.append(bytes, sizeof(bytes));
+}
+
+static void AppendString(QByteArray& frame, const QString& string)
+{
+  const QByteArray utf8 = string.toUtf8();
+  AppendUint32(frame, static_cast<quint32>(utf8.size()));
+  frame.append(utf8);
+}
+
+static QByteArray EncodeFrame(const OpenRequest& request)
+{
+  // The size comes first, it is known at the end.
+  QByteArray frame(sizeof(quint32), '\0');
+  AppendUint32(frame, static_cast<quint32>(request.arguments.size() + 1));
+  AppendString(frame, request.workingDirectory);
+  for (const QString& argument : request.arguments) {
+    AppendString(frame, argument);
+  }
+  qToBigEndian(static_cast<quint32>(frame.size() - sizeof(quint32)), frame.data());
+  return frame;
+}
+
+static bool DecodeFrame(const QByteArray& frame, OpenRequest& request)
+{
+  qsizetype offset = 0;
+  auto readUint32 = [&frame, &offset](quint32& value) {
+    if (frame.size() - offset < static_cast<qsizetype>(sizeof(quint32))) {
+      return false;
+    }
+    value = qFromBigEndian<quint32>(frame.constData() + offset);
+    offset += sizeof(quint32);
+    return true;
+  };
+
+  quint32 count = 0;
+  if (!readUint32(count) || count == 0) {
+    return false;
+  }
+
+  for (quint32 index = 0; index < count; ++index) {
+    quint32 size = 0;
+    if (!readUint32(size) || frame.size() - offset < static_cast<qsizetype>(size)) {
+      return false;
+    }
+
+    const QString string = QString::fromUtf8(frame.constData() + offset, size);
+    offset += size;
+    if (index == 0) {
+      request.workingDirectory = string;
+    } else {
+      request.arguments.append(string);
+    }
+  }
+
+  return offset == frame.size();
+}
+
+OpenRequestServer::OpenRequestServer(const QString& applicationId, QObject* parent)
+  : QObject(parent)
+  , _applicationId(applicationId)
+  , _server(new QLocalServer(this))
+{
+  _server->setSocketOptions(QLocalServer::UserAccessOption);
+  _batchTimer.setSingleShot(true);
+  _batchTimer.setInterval(50);
+
+  connect(&_batchTimer, &QTimer::timeout, this, &OpenRequestServer::emitBatch);
+  connect(_server, &QLocalServer::newConnection, this, [this]() {
+    while (_server->hasPendingConnections()) {
+      QLocalSocket* socket = _server->nextPendingConnection();
+      connect(socket, &QLocalSocket::readyRead, this, [this, socket]() {
+        readFrame(socket);
+      });
+      connect(socket, &QLocalSocket::disconnected, socket, &QObject::deleteLater);
+      readFrame(socket);
+    }
+  });
+}
+
+OpenRequestServer::~OpenRequestServer()
+{
+}
+
+QString OpenRequestServer::serverName(const QString& applicationId)
+{
+  QString user = qEnvironmentVariable("USER");
+  if (user.isEmpty()) {
+    user = qEnvironmentVariable("USERNAME");
+  }
+  return applicationId + "-" + user;
+}
+
+bool OpenRequestServer::forward(const QString& applicationId, const OpenRequest& request, int timeout)
+{
+  // The primary would drop it, the launch goes through QtSingleApplication
+  // instead.
+  const QByteArray frame = EncodeFrame(request);
+  if (frame.size() - static_cast<qsizetype>(sizeof(quint32)) > static_cast<qsizetype>(kMaximumFrameSize)) {
+    return false;
+  }
+
+  QLocalSocket socket;
+  socket.connectToServer(serverName(applicationId));
+  if (!socket.waitForConnected(timeout)) {
+    return false;
+  }
+
+  socket.write(frame);
+  socket.flush();
+  while (socket.bytesToWrite() > 0) {
+    if (!socket.waitForBytesWritten(timeout)) {
+      return false;
+    }
+  }
+
+  // The primary disconnects once it read the frame, there is no reply to
+  // wait for.
+  socket.disconnectFromServer();
+  return true;
+}
+
+QString OpenRequestServer::encodeMessage(const OpenRequest& request)
+{
+  return (QStringList(request.workingDirectory) + request.arguments).join(QChar(0));
+}
+
+OpenRequest OpenRequestServer::decodeMessage(const QString& message)
+{
+  QStringList strings = message.split(QChar(0));
+  OpenRequest request;
+  request.workingDirectory = strings.takeFirst();
+  request.arguments = std::move(strings);
+  return request;
+}
+
+bool OpenRequestServer::listen()
+{
+  const QString name = serverName(_applicationId);
+  QLocalServer::removeServer(name);
+  return _server->listen(name);
+}
+
+void OpenRequestServer::setCoalescingInterval(int coalescingInterval)
+{
+  _batchTimer.setInterval(coalescingInterval);
+}
+
+void OpenRequestServer::addRequest(OpenRequest request)
+{
+  _batch.push_back(std::move(request));
+  // Not restarted by later requests, so a steady stream of launches is
+  // still opened every interval.
+  if (!_batchTimer.isActive()) {
+    _batchTimer.start();
+  }
+}
+
+void OpenRequestServer::readFrame(QLocalSocket* socket)
+{
+  char header[sizeof(quint32)];
+  if (socket->peek(header, sizeof(header)) < static_cast<qint64>(sizeof(header))) {
+    return;
+  }
+
+  const quint32 size = qFromBigEndian<quint32>(header);
+  if (size > kMaximumFrameSize) {
+    socket->abort();
+    socket->deleteLater();
+    return;
+  }
+  if (socket->bytesAvailable() < static_cast<qint64>(sizeof(header) + size)) {
+    return;
+  }
+
+  socket->read(header, sizeof(header));
+  OpenRequest request;
+  if (DecodeFrame(socket->read(size), request)) {
+    addRequest(std::move(request));
+  }
+  // One launch per connection.
+  socket->disconnectFromServer();
+}
+
+void OpenRequestServer::emitBatch()
+{
+  std::vector<OpenRequest> batch;
+  batch.swap(_batch);
+  Q_EMIT openRequested(batch);
+}
@@ -0,0 +1,74 @@
+#ifndef OPENREQUESTSERVER_H
+#define OPENREQUESTSERVER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+#include <QTimer>
+
+#include <vector>
+
+class QLocalServer;
+class QLocalSocket;
+
+struct OpenRequest
+{
+  // Of the launch, for resolving relative paths.
+  QString workingDirectory;
+  QStringList arguments;
+};
+
+// Receives the arguments of later launches in the primary instance. A later
+// launch calls forward() before it creates a QApplication, so it sends its
+// arguments and exits without creating widgets or loading plugins.
+//
+// Every launch is one frame on its own connection: the big endian frame size,
+// the string count and every string as its big endian size and UTF-8 bytes,
+// the first string being the working directory.
+//
+// The requests that arrive within the coalescing interval of the first one
+// are reported together, so a burst of launches from a file browser opens as
+// one batch.
+class OpenRequestServer : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit OpenRequestServer(const QString& applicationId, QObject* parent = nullptr);
+  ~OpenRequestServer() override;
+
+  // Per user, so the instances of different users do not talk to each other.
+  static QString serverName(const QString& applicationId);
+  // Returns false when there is no primary instance listening or the
+  // arguments are too large for a frame.
+  static bool forward(const QString& applicationId, const OpenRequest& request, int timeout = 1000);
+
+  static QString encodeMessage(const OpenRequest& request);
+  static OpenRequest decodeMessage(const QString& message);
+
+  // Only call it in the primary instance, it removes a stale server that a
+  // crashed primary left behind.
+  bool listen();
+
+  // In milliseconds, defaults to 50.
+  void setCoalescingInterval(int coalescingInterval);
+  int coalescingInterval() const { return _batchTimer.interval(); }
+
+  // For requests that arrive another way, e.g. QtSingleApplication::messageReceived().
+  void addRequest(OpenRequest request);
+
+Q_SIGNALS:
+  // In the order of arrival.
+  void openRequested(const std::vector<OpenRequest>& requests);
+
+private:
+  void readFrame(QLocalSocket* socket);
+  void emitBatch();
+
+  QString _applicationId;
+  QLocalServer* _server;
+  std::vector<OpenRequest> _batch;
+  QTimer _batchTimer;
+};
+
+#endif
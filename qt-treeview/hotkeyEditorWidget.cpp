@@ -9,209 +9,128 @@
 
 static const char* kDefaultShortcutPropertyName = "defaultShortcut";
 
-HotkeyEditorModelItem::HotkeyEditorModelItem(const std::vector<QVariant>& data, HotkeyEditorModelItem* parent)
-  : m_itemData(data)
-  , m_parentItem(parent)
-{
-}
-
-HotkeyEditorModelItem::~HotkeyEditorModelItem()
-{
-  qDeleteAll(m_childItems);
-}
-
-void HotkeyEditorModelItem::appendChild(HotkeyEditorModelItem *item)
-{
-  m_childItems.push_back(item);
-}
-
-HotkeyEditorModelItem *HotkeyEditorModelItem::child(int row)
-{
-  if (row < 0 || static_cast<size_t>(row) >= m_childItems.size()) {
-    return nullptr;
-  }
-
-  return m_childItems.at(row);
-}
-
-int HotkeyEditorModelItem::childCount() const
+HotkeyEditorModel::HotkeyEditorModel(QObject* parent)
+  : ActionTreeModel(static_cast<int>(Column::DefaultHotkey) + 1, parent)
 {
-  return m_childItems.size();
 }
 
-int HotkeyEditorModelItem::row() const
+void HotkeyEditorModel::setHotkeys(HotkeysMap hotkeys)
 {
-  if (m_parentItem) {
-    auto it = std::find(m_parentItem->m_childItems.cbegin(), m_parentItem->m_childItems.cend(), const_cast<HotkeyEditorModelItem*>(this));
-    if (it != m_parentItem->m_childItems.cend()) {
-      return std::distance(m_parentItem->m_childItems.cbegin(), it);
-    }
-    else {
-      return -1;
-    }
-  }
-
-  return 0;
-}
-
-int HotkeyEditorModelItem::columnCount() const
-{
-    return m_itemData.size();
+  beginResetModel();
+  _hotkeys = std::move(hotkeys);
+  setupModelData(rootItem());
+  endResetModel();
 }
 
-QVariant HotkeyEditorModelItem::data(int column) const
+QVariant HotkeyEditorModel::data(const QModelIndex &index, int role) const
 {
-  if (column < 0 || static_cast<size_t>(column) >= m_itemData.size()) {
+  if (!index.isValid()) {
     return QVariant();
   }
 
-  QVariant columnVariant = m_itemData.at(column);
-  if (column != static_cast<int>(Column::Hotkey) || columnVariant.canConvert<QString>()) {
-    return columnVariant;
-  }
-
-  QAction* action = static_cast<QAction*>(columnVariant.value<void*>());
-  if (!action) {
+  if (role != Qt::DisplayRole) {
     return QVariant();
   }
-  QKeySequence keySequence = action->shortcut();
-  QString keySequenceString = keySequence.toString(QKeySequence::NativeText);
-  return keySequenceString;
-}
 
-HotkeyEditorModelItem *HotkeyEditorModelItem::parentItem()
-{
-  return m_parentItem;
-}
-
-HotkeyEditorModel::HotkeyEditorModel(QObject* parent)
-  : QAbstractItemModel(parent)
-{
-  rootItem = new HotkeyEditorModelItem({tr("Name"), tr("Hotkey"), QString()});
-}
-
-HotkeyEditorModel::~HotkeyEditorModel()
-{
-  delete rootItem;
-}
+  HotkeyEditorItemData& itemData = itemFromIndex(index)->data();
+  switch (static_cast<Column>(index.column())) {
+    case Column::Name:
+      return itemData.name;
+    case Column::Hotkey:
+      if (!itemData.action) {
+        return QVariant();
+      }
+      return itemData.action->shortcut().toString(QKeySequence::NativeText);
+    case Column::DefaultHotkey:
+      if (!itemData.action) {
+        return QVariant();
+      }
+      if (!itemData.defaultHotkey) {
+        itemData.defaultHotkey = itemData.action->property(kDefaultShortcutPropertyName).value<QKeySequence>().toString(QKeySequence::NativeText);
+      }
+      return *itemData.defaultHotkey;
+  }
 
-void HotkeyEditorModel::setHotkeys(const HotkeysMap& hotkeys)
-{
-  beginResetModel();
-  _hotkeys = hotkeys;
-  setupModelData(rootItem);
-  endResetModel();
+  return QVariant();
 }
 
-QModelIndex HotkeyEditorModel::index(int row, int column, const QModelIndex &parent) const
+QVariant HotkeyEditorModel::headerData(int section, Qt::Orientation orientation, int role) const
 {
-  if (!hasIndex(row, column, parent)) {
-    return QModelIndex();
-  }
-
-  HotkeyEditorModelItem *parentItem;
-
-  if (!parent.isValid()) {
-    parentItem = rootItem;
-  }
-  else {
-    parentItem = static_cast<HotkeyEditorModelItem*>(parent.internalPointer());
+  if (orientation != Qt::Horizontal || role != Qt::DisplayRole) {
+    return QVariant();
   }
 
-  HotkeyEditorModelItem *childItem = parentItem->child(row);
-  if (childItem) {
-    return createIndex(row, column, childItem);
+  switch (static_cast<Column>(section)) {
+    case Column::Name:
+      return tr("Name");
+    case Column::Hotkey:
+      return tr("Hotkey");
+    case Column::DefaultHotkey:
+      return QString();
   }
 
-  return QModelIndex();
+  return QVariant();
 }
 
-QModelIndex HotkeyEditorModel::parent(const QModelIndex &index) const
+bool HotkeyEditorModel::hasChildren(const QModelIndex& parent) const
 {
-  if (!index.isValid()) {
-    return QModelIndex();
+  if (canFetchMore(parent)) {
+    return true;
   }
 
-  HotkeyEditorModelItem *childItem = static_cast<HotkeyEditorModelItem*>(index.internalPointer());
-  HotkeyEditorModelItem *parentItem = childItem->parentItem();
-
-  if (parentItem == rootItem) {
-    return QModelIndex();
-  }
-
-  return createIndex(parentItem->row(), 0, parentItem);
+  return ActionTreeModel::hasChildren(parent);
 }
 
-int HotkeyEditorModel::rowCount(const QModelIndex &parent) const
+bool HotkeyEditorModel::canFetchMore(const QModelIndex& parent) const
 {
-  HotkeyEditorModelItem *parentItem;
   if (parent.column() > 0) {
-    return 0;
+    return false;
   }
 
-  if (!parent.isValid()) {
-    parentItem = rootItem;
-  }
-  else {
-    parentItem = static_cast<HotkeyEditorModelItem*>(parent.internalPointer());
-  }
-
-  return parentItem->childCount();
+  const std::vector<QAction*>* pendingActions = itemFromIndex(parent)->data().pendingActions;
+  return pendingActions && !pendingActions->empty();
 }
 
-int HotkeyEditorModel::columnCount(const QModelIndex &parent) const
+void HotkeyEditorModel::fetchMore(const QModelIndex& parent)
 {
-  if (parent.isValid()) {
-    return static_cast<HotkeyEditorModelItem*>(parent.internalPointer())->columnCount();
+  if (!canFetchMore(parent)) {
+    return;
   }
 
-  return rootItem->columnCount();
-}
+  HotkeyEditorModelItem* categoryLevelItem = itemFromIndex(parent);
+  const std::vector<QAction*>& actions = *categoryLevelItem->data().pendingActions;
+  categoryLevelItem->data().pendingActions = nullptr;
 
-QVariant HotkeyEditorModel::data(const QModelIndex &index, int role) const
-{
-  if (!index.isValid()) {
-    return QVariant();
+  int count = 0;
+  for (QAction* action : actions) {
+    if (action != nullptr && !action->text().isEmpty()) {
+      ++count;
+    }
   }
-
-  if (role != Qt::DisplayRole) {
-    return QVariant();
+  if (count == 0) {
+    return;
   }
 
-  HotkeyEditorModelItem *item = static_cast<HotkeyEditorModelItem*>(index.internalPointer());
-  return item->data(index.column());
-}
-
-QVariant HotkeyEditorModel::headerData(int section, Qt::Orientation orientation, int role) const
-{
-  if (orientation == Qt::Horizontal && role == Qt::DisplayRole) {
-    return rootItem->data(section);
+  beginInsertRows(parent, 0, count - 1);
+  for (QAction* action : actions) {
+    if (action == nullptr || action->text().isEmpty()) {
+      continue;
+    }
+    categoryLevelItem->appendChild({action->text(), action});
   }
-
-  return QVariant();
+  endInsertRows();
 }
 
 void HotkeyEditorModel::setupModelData(HotkeyEditorModelItem *parent)
 {
-  QAction* nullAction = nullptr;
-  const QString contextIdPrefix = "root";
+  parent->clear();
   // Go through each context, one context - many categories each iteration
   for (const auto& contextLevel : _hotkeys) {
-    HotkeyEditorModelItem* contextLevelItem = new HotkeyEditorModelItem({contextLevel.first, QVariant::fromValue(nullAction), QString()}, parent);
-    parent->appendChild(contextLevelItem);
+    HotkeyEditorModelItem* contextLevelItem = parent->appendChild({contextLevel.first});
     // Go through each category, one category - many actions each iteration
     for (const auto& categoryLevel : contextLevel.second) {
-      HotkeyEditorModelItem* categoryLevelItem = new HotkeyEditorModelItem({categoryLevel.first, QVariant::fromValue(nullAction), QString()}, contextLevelItem);
-      contextLevelItem->appendChild(categoryLevelItem);
-      for (const auto& action : categoryLevel.second) {
-        QString name = action->text();
-        if (name.isEmpty() || action == nullptr) {
-          continue;
-        }
-        QString defaultHotkey = action->property(kDefaultShortcutPropertyName).value<QKeySequence>().toString(QKeySequence::NativeText);
-        HotkeyEditorModelItem* actionLevelItem = new HotkeyEditorModelItem({name, QVariant::fromValue(reinterpret_cast<void*>(action)), defaultHotkey}, categoryLevelItem);
-        categoryLevelItem->appendChild(actionLevelItem);
-      }
+      // The actions are only added when the category is expanded.
+      contextLevelItem->appendChild({categoryLevel.first, nullptr, &categoryLevel.second});
     }
   }
 }
@@ -241,5 +160,5 @@ HotkeyEditorWidget::HotkeyEditorWidget(QWidget* parent) :
   CategoryHotkeysMap categoryHotkeys;
   categoryHotkeys.insert({"Category", actions});
   hotkeys.insert({"Context", categoryHotkeys});
-  _model->setHotkeys(hotkeys);
+  _model->setHotkeys(std::move(hotkeys));
 }
@@ -1,11 +1,16 @@
 #ifndef HOTKEYEDITORWIDGET_H
 #define HOTKEYEDITORWIDGET_H
 
-#include <QAbstractItemModel>
+#include "actionTreeModel.h"
+
 #include <QString>
 #include <QWidget>
 
+#include <map>
+#include <optional>
 #include <string>
+#include <utility>
+#include <vector>
 
 class QAction;
 class QModelIndex;
@@ -22,49 +27,40 @@ enum class Column : uint8_t {
   DefaultHotkey
 };
 
-class HotkeyEditorModelItem
+struct HotkeyEditorItemData
 {
-public:
-    explicit HotkeyEditorModelItem(const std::vector<QVariant>& data,
-                                   HotkeyEditorModelItem* parentItem = nullptr);
-    ~HotkeyEditorModelItem();
-
-    void appendChild(HotkeyEditorModelItem *child);
-
-    HotkeyEditorModelItem *child(int row);
-    int childCount() const;
-    int columnCount() const;
-    QVariant data(int column) const;
-    int row() const;
-    HotkeyEditorModelItem *parentItem();
-    QAction* action() const;
-
-private:
-    std::vector<HotkeyEditorModelItem*> m_childItems;
-    std::vector<QVariant> m_itemData;
-    HotkeyEditorModelItem *m_parentItem;
+  QString name;
+  // Null for the context and category rows.
+  QAction* action = nullptr;
+  // The actions of a category row that are not children yet. They are added
+  // when the row is first expanded.
+  const std::vector<QAction*>* pendingActions = nullptr;
+  // Read from the action when the row is first shown.
+  std::optional<QString> defaultHotkey;
 };
 
-class HotkeyEditorModel : public QAbstractItemModel
+using HotkeyEditorModelItem = ActionTreeItem<HotkeyEditorItemData>;
+
+class HotkeyEditorModel : public ActionTreeModel<HotkeyEditorItemData>
 {
   Q_OBJECT
 
 public:
   explicit HotkeyEditorModel(QObject* parent = nullptr);
-  ~HotkeyEditorModel() override;
+  ~HotkeyEditorModel() override = default;
 
   QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
   QVariant headerData(int section, Qt::Orientation orientation, int role = Qt::DisplayRole) const override;
-  QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
-  QModelIndex parent(const QModelIndex& index) const override;
-  int rowCount(const QModelIndex& index = QModelIndex()) const override;
-  int columnCount(const QModelIndex& index = QModelIndex()) const override;
-  void setHotkeys(const HotkeysMap& hotkeys);
+  bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+  bool canFetchMore(const QModelIndex& parent) const override;
+  void fetchMore(const QModelIndex& parent) override;
+
+  // The category rows refer to the actions in hotkeys, the model keeps them.
+  void setHotkeys(HotkeysMap hotkeys);
 
 private:
   void setupModelData(HotkeyEditorModelItem* parent);
 
-  HotkeyEditorModelItem* rootItem;
   HotkeysMap _hotkeys;
 };
 
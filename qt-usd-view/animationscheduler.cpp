@@ -0,0 +1,90 @@
+#include "animationscheduler.h"
+
+#include <QOpenGLWidget>
+
+#ifdef Q_OS_WIN
+#include <windows.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#include <iostream>
+
+static double ProcessCpuSeconds()
+{
+#ifdef Q_OS_WIN
+  FILETIME creation;
+  FILETIME exitTime;
+  FILETIME kernel;
+  FILETIME user;
+  GetProcessTimes(GetCurrentProcess(), &creation, &exitTime, &kernel, &user);
+  auto seconds = [](const FILETIME& time) {
+    return ((static_cast<quint64>(time.dwHighDateTime) << 32) | time.dwLowDateTime) / 1e7;
+  };
+  return seconds(kernel) + seconds(user);
+#else
+  rusage usage;
+  getrusage(RUSAGE_SELF, &usage);
+  return usage.ru_utime.tv_sec + usage.ru_stime.tv_sec
+    + (usage.ru_utime.tv_usec + usage.ru_stime.tv_usec) / 1e6;
+#endif
+}
+
+AnimationScheduler::AnimationScheduler(QOpenGLWidget* target)
+  : QObject(target)
+  , _target(target)
+{
+  connect(target, &QOpenGLWidget::frameSwapped, this, &AnimationScheduler::frameSwapped);
+  _idleTimer.start();
+  _idleCpuStart = ProcessCpuSeconds();
+}
+
+void AnimationScheduler::wake()
+{
+  _target->update();
+}
+
+qint64 AnimationScheduler::beginFrame()
+{
+  if (!_idle) {
+    return _frameTimer.restart();
+  }
+
+  _idle = false;
+
+  // Short gaps between input events are not worth reporting.
+  const double idleSeconds = _idleTimer.elapsed() / 1000.0;
+  if (idleSeconds >= 1.0) {
+    const double cpuSeconds = ProcessCpuSeconds() - _idleCpuStart;
+    std::cout << "idle for " << idleSeconds << " s at " << 100.0 * cpuSeconds / idleSeconds << "% CPU" << std::endl;
+  }
+
+  _frameTimer.start();
+  _rateTimer.start();
+  _frames = 0;
+  return 0;
+}
+
+void AnimationScheduler::endFrame(bool animating)
+{
+  ++_frames;
+  if (_rateTimer.elapsed() >= 1000) {
+    std::cout << "animating at " << _frames * 1000.0 / _rateTimer.elapsed() << " fps" << std::endl;
+    _rateTimer.restart();
+    _frames = 0;
+  }
+
+  _animating = animating;
+  if (!_animating) {
+    _idle = true;
+    _idleTimer.start();
+    _idleCpuStart = ProcessCpuSeconds();
+  }
+}
+
+void AnimationScheduler::frameSwapped()
+{
+  if (_animating) {
+    _target->update();
+  }
+}
@@ -0,0 +1,44 @@
+#ifndef ANIMATIONSCHEDULER_H
+#define ANIMATIONSCHEDULER_H
+
+#include <QElapsedTimer>
+#include <QObject>
+
+class QOpenGLWidget;
+
+// Drives redraws of a QOpenGLWidget only while something is animating.
+//
+// While animating, the next frame is requested when the previous one has been
+// swapped, which paces rendering to vsync. Otherwise no frames are requested
+// until wake() is called, so an idle viewport costs no CPU or GPU time.
+class AnimationScheduler : public QObject
+{
+  Q_OBJECT
+
+public:
+  explicit AnimationScheduler(QOpenGLWidget* target);
+
+  void wake();
+  bool isAnimating() const { return _animating; }
+
+  // Milliseconds since the previous frame, or 0 for the first frame after
+  // idling.
+  qint64 beginFrame();
+  void endFrame(bool animating);
+
+private:
+  void frameSwapped();
+
+  QOpenGLWidget* _target;
+  bool _animating = false;
+  bool _idle = true;
+  QElapsedTimer _frameTimer;
+
+  QElapsedTimer _rateTimer;
+  int _frames = 0;
+
+  QElapsedTimer _idleTimer;
+  double _idleCpuStart = 0.0;
+};
+
+#endif
@@ -0,0 +1,109 @@
+#include "boundshierarchy.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+PXR_NAMESPACE_USING_DIRECTIVE
+
+static const int LeafSize = 4;
+
+void BoundsHierarchy::build(const std::vector<GfRange3d>& bounds)
+{
+  _nodes.clear();
+  _items.resize(bounds.size());
+  std::iota(_items.begin(), _items.end(), 0);
+  if (!bounds.empty()) {
+    _nodes.reserve(2 * bounds.size() / LeafSize + 1);
+    build(bounds, 0, static_cast<int>(bounds.size()));
+  }
+}
+
+int BoundsHierarchy::build(const std::vector<GfRange3d>& bounds, int first, int count)
+{
+  const int index = static_cast<int>(_nodes.size());
+  _nodes.emplace_back();
+
+  GfRange3d nodeBounds;
+  GfRange3d centers;
+  for (int i = first; i < first + count; ++i) {
+    nodeBounds.UnionWith(bounds[_items[i]]);
+    centers.UnionWith(bounds[_items[i]].GetMidpoint());
+  }
+  _nodes[index].bounds = nodeBounds;
+
+  if (count <= LeafSize) {
+    _nodes[index].first = first;
+    _nodes[index].count = count;
+    return index;
+  }
+
+  // Median split along the axis where the box centers spread the most.
+  const GfVec3d size = centers.GetSize();
+  const int axis = size[0] >= size[1] && size[0] >= size[2] ? 0 : (size[1] >= size[2] ? 1 : 2);
+  const int half = count / 2;
+  std::nth_element(_items.begin() + first, _items.begin() + first + half, _items.begin() + first + count,
+      [&bounds, axis](int a, int b) {
+        return bounds[a].GetMidpoint()[axis] < bounds[b].GetMidpoint()[axis];
+      });
+
+  build(bounds, first, half);
+  const int second = build(bounds, first + half, count - half);
+  _nodes[index].second = second;
+  return index;
+}
+
+void BoundsHierarchy::refit(const std::vector<GfRange3d>& bounds)
+{
+  // Children always come after their parent.
+  for (int index = static_cast<int>(_nodes.size()) - 1; index >= 0; --index) {
+    Node& node = _nodes[index];
+    if (node.count > 0) {
+      node.bounds = GfRange3d();
+      for (int i = node.first; i < node.first + node.count; ++i) {
+        node.bounds.UnionWith(bounds[_items[i]]);
+      }
+    }
+    else {
+      node.bounds = GfRange3d::GetUnion(_nodes[index + 1].bounds, _nodes[node.second].bounds);
+    }
+  }
+}
+
+int BoundsHierarchy::intersect(const GfRay& ray, const ItemTest& test) const
+{
+  int nearest = -1;
+  double nearestDistance = std::numeric_limits<double>::max();
+
+  std::vector<int> stack;
+  if (!_nodes.empty()) {
+    stack.push_back(0);
+  }
+  while (!stack.empty()) {
+    const int index = stack.back();
+    const Node& node = _nodes[index];
+    stack.pop_back();
+
+    double enter;
+    double exit;
+    if (!ray.Intersect(node.bounds, &enter, &exit) || enter >= nearestDistance) {
+      continue;
+    }
+
+    if (node.count == 0) {
+      stack.push_back(node.second);
+      stack.push_back(index + 1);
+      continue;
+    }
+
+    for (int i = node.first; i < node.first + node.count; ++i) {
+      double distance;
+      if (test(_items[i], &distance) && distance < nearestDistance) {
+        nearest = _items[i];
+        nearestDistance = distance;
+      }
+    }
+  }
+
+  return nearest;
+}
@@ -0,0 +1,42 @@
+#ifndef BOUNDSHIERARCHY_H
+#define BOUNDSHIERARCHY_H
+
+#include <pxr/base/gf/range3d.h>
+#include <pxr/base/gf/ray.h>
+
+#include <functional>
+#include <vector>
+
+// Bounding volume hierarchy over a fixed set of boxes. The boxes may move
+// afterwards; refit() updates the node bounds without rebuilding the tree.
+class BoundsHierarchy
+{
+public:
+  // Exact test for the item at index, which is only called when the ray hits
+  // its box. Returns whether the item was hit and at which ray distance.
+  using ItemTest = std::function<bool(int index, double* distance)>;
+
+  void build(const std::vector<pxr::GfRange3d>& bounds);
+  void refit(const std::vector<pxr::GfRange3d>& bounds);
+  bool isEmpty() const { return _nodes.empty(); }
+
+  // Returns the index of the nearest item hit by ray, or -1.
+  int intersect(const pxr::GfRay& ray, const ItemTest& test) const;
+
+private:
+  struct Node
+  {
+    pxr::GfRange3d bounds;
+    // Children are at index + 1 and at second. Leaves have count > 0.
+    int second = 0;
+    int first = 0;
+    int count = 0;
+  };
+
+  int build(const std::vector<pxr::GfRange3d>& bounds, int first, int count);
+
+  std::vector<Node> _nodes;
+  std::vector<int> _items;
+};
+
+#endif
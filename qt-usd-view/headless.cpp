@@ -0,0 +1,189 @@
+#include "headless.h"
+
+#include "scene.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QImage>
+#include <QOffscreenSurface>
+#include <QOpenGLContext>
+#include <QOpenGLFramebufferObject>
+#include <QOpenGLFunctions>
+#include <QTextStream>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <memory>
+#include <vector>
+
+// Scene::prepare takes tenths of a second, like View::paintGL passes them.
+static const float FrameStep = 1000.0f / 60.0f / 100.0f;
+
+static bool IsCoordinate(const QString& word)
+{
+  bool ok = false;
+  const float value = word.toFloat(&ok);
+  return ok && std::isfinite(value);
+}
+
+static bool ParseScript(const QString& path, std::vector<QStringList>& commands)
+{
+  if (path.isEmpty()) {
+    commands.push_back({ "frames", "300" });
+    return true;
+  }
+
+  QFile file(path);
+  if (!file.open(QIODevice::ReadOnly | QIODevice::Text)) {
+    std::cerr << "Failed to read " << qPrintable(path) << std::endl;
+    return false;
+  }
+
+  QTextStream stream(&file);
+  for (int line = 1; !stream.atEnd(); ++line) {
+    QString text = stream.readLine();
+    text.truncate(text.indexOf('#') < 0 ? text.size() : text.indexOf('#'));
+    const QStringList words = text.split(' ', Qt::SkipEmptyParts);
+    if (words.isEmpty()) {
+      continue;
+    }
+
+    const QString& name = words[0];
+    const bool valid = (name == "frames" && words.size() == 2 && words[1].toInt() > 0)
+      || ((name == "hover" || name == "click") && words.size() == 3 && IsCoordinate(words[1]) && IsCoordinate(words[2]))
+      || (name == "capture" && words.size() == 2);
+    if (!valid) {
+      std::cerr << qPrintable(path) << ":" << line << ": invalid command " << qPrintable(text) << std::endl;
+      return false;
+    }
+    commands.push_back(words);
+  }
+  return true;
+}
+
+static double Percentile(const std::vector<qint64>& sorted, double p)
+{
+  const size_t rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+  return sorted[std::clamp<size_t>(rank, 1, sorted.size()) - 1] / 1e6;
+}
+
+static void Report(const char* name, std::vector<qint64> times)
+{
+  if (times.empty()) {
+    return;
+  }
+
+  qint64 total = 0;
+  for (const qint64 time : times) {
+    total += time;
+  }
+  std::sort(times.begin(), times.end());
+
+  std::cout << name << ": " << times.size() << " x, mean " << total / 1e6 / times.size()
+            << " ms, p50 " << Percentile(times, 0.50)
+            << " ms, p90 " << Percentile(times, 0.90)
+            << " ms, p99 " << Percentile(times, 0.99)
+            << " ms, max " << times.back() / 1e6 << " ms" << std::endl;
+}
+
+int RunHeadless(const HeadlessOptions& options)
+{
+  std::vector<QStringList> commands;
+  if (!ParseScript(options.scriptPath, commands)) {
+    return 1;
+  }
+
+  QOffscreenSurface surface;
+  surface.setFormat(QSurfaceFormat::defaultFormat());
+  surface.create();
+
+  QOpenGLContext context;
+  context.setFormat(QSurfaceFormat::defaultFormat());
+  if (!context.create() || !context.makeCurrent(&surface)) {
+    std::cerr << "Failed to create an offscreen OpenGL context" << std::endl;
+    return 1;
+  }
+
+  QOpenGLFunctions* f = context.functions();
+  const int width = options.size.width();
+  const int height = options.size.height();
+
+  std::vector<qint64> frameTimes;
+  std::vector<qint64> hoverTimes;
+  std::vector<qint64> clickTimes;
+  int result = 0;
+
+  {
+    QOpenGLFramebufferObject fbo(options.size, QOpenGLFramebufferObject::CombinedDepthStencil);
+    fbo.bind();
+
+    // The same state View::initializeGL and View::paintGL set up.
+    f->glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
+
+    QElapsedTimer timer;
+    timer.start();
+    std::unique_ptr<Scene> scene(new Scene(options.columns, options.rows, options.seed));
+    scene->setPlayback(options.playback);
+    std::cout << "scene: " << timer.nsecsElapsed() / 1e6 << " ms" << std::endl;
+
+    auto render = [&](float seconds) {
+      fbo.bind();
+      f->glViewport(0, 0, width, height);
+      f->glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
+      f->glEnable(GL_DEPTH_TEST);
+      f->glDepthFunc(GL_LESS);
+      f->glEnable(GL_BLEND);
+      scene->prepare(seconds);
+      scene->draw(width, height);
+      // Without a swap nothing waits for the GPU, the frame time should.
+      f->glFinish();
+    };
+
+    // The first frame populates Hydra, it is reported on its own.
+    timer.start();
+    render(0.0f);
+    std::cout << "first frame: " << timer.nsecsElapsed() / 1e6 << " ms" << std::endl;
+
+    for (const QStringList& command : commands) {
+      const QString& name = command[0];
+      if (name == "frames") {
+        const int count = command[1].toInt();
+        for (int frame = 0; frame < count; ++frame) {
+          timer.start();
+          render(FrameStep);
+          frameTimes.push_back(timer.nsecsElapsed());
+        }
+      }
+      else if (name == "hover" || name == "click") {
+        // Validated by ParseScript.
+        const float x = command[1].toFloat();
+        const float y = command[2].toFloat();
+        timer.start();
+        scene->cursor(x, y);
+        hoverTimes.push_back(timer.nsecsElapsed());
+        if (name == "click") {
+          timer.start();
+          scene->click();
+          clickTimes.push_back(timer.nsecsElapsed());
+        }
+      }
+      else if (name == "capture") {
+        if (!fbo.toImage().save(command[1])) {
+          std::cerr << "Failed to write " << qPrintable(command[1]) << std::endl;
+          result = 1;
+        }
+      }
+    }
+
+    scene.reset();
+    QOpenGLFramebufferObject::bindDefault();
+  }
+
+  context.doneCurrent();
+
+  Report("frame", frameTimes);
+  Report("hover", hoverTimes);
+  Report("click", clickTimes);
+  return result;
+}
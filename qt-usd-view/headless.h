@@ -0,0 +1,31 @@
+#ifndef HEADLESS_H
+#define HEADLESS_H
+
+#include <QSize>
+#include <QString>
+
+struct HeadlessOptions
+{
+  int columns = 4;
+  int rows = 4;
+  unsigned seed = 0;
+  QSize size = QSize(1280, 720);
+  bool playback = false;
+  // Without a script the board plays its startup animation for 300 frames.
+  QString scriptPath;
+};
+
+// Runs a script against the scene in an offscreen framebuffer, without a
+// window, and prints timings for the first frame, frames, picks and clicks.
+// Frames advance by a fixed 1/60 s, so a run only depends on its options.
+//
+// The script has one command per line, # starts a comment:
+//   frames <count>        render count frames
+//   hover <x> <y>         move the cursor, in 0..1 viewport coordinates
+//   click <x> <y>         move the cursor and click
+//   capture <file>        save the current frame
+//
+// Returns the process exit code.
+int RunHeadless(const HeadlessOptions& options);
+
+#endif
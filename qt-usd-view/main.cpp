@@ -1,14 +1,97 @@
+#include "headless.h"
 #include "view.h"
 
 #include <QDir>
 #include <QApplication>
+#include <QCommandLineParser>
 
+#include <pxr/base/trace/collector.h>
+#include <pxr/base/trace/reporter.h>
+
+#include <ctime>
+#include <fstream>
+#include <iostream>
+
+// Headless runs need no display but still a GL driver, e.g. Mesa llvmpipe:
+// QT_QPA_PLATFORM=offscreen LIBGL_ALWAYS_SOFTWARE=1 QtUsdView --headless
 int main(int argc, char **argv)
 {
   qputenv("PATH", qPrintable(QDir::currentPath()));
   qputenv("QT_PLUGIN_PATH", qPrintable(QDir::currentPath()));
   QApplication app(argc, argv);
-  View view;
-  view.show();
-  return app.exec();
+
+  QCommandLineParser parser;
+  parser.addHelpOption();
+  QCommandLineOption boardOption("board", "Number of switch columns and rows.", "NxM", "4x4");
+  parser.addOption(boardOption);
+  QCommandLineOption profileOption("profile", "Write a Chrome trace (chrome://tracing) of the session to a file on exit.", "file");
+  parser.addOption(profileOption);
+  QCommandLineOption seedOption("seed", "Seed for the initial switch turns, random by default.", "number");
+  parser.addOption(seedOption);
+  QCommandLineOption playbackOption("playback", "Animate through time samples instead of authoring every frame.");
+  parser.addOption(playbackOption);
+  QCommandLineOption headlessOption("headless", "Run a script offscreen without a window and report timings.");
+  parser.addOption(headlessOption);
+  QCommandLineOption scriptOption("script", "Commands for the headless run, see headless.h.", "file");
+  parser.addOption(scriptOption);
+  QCommandLineOption sizeOption("size", "Framebuffer size in headless mode.", "WxH", "1280x720");
+  parser.addOption(sizeOption);
+  parser.process(app);
+
+  const QStringList board = parser.value(boardOption).split('x');
+  const int columns = board.size() == 2 ? board[0].toInt() : 0;
+  const int rows = board.size() == 2 ? board[1].toInt() : 0;
+  if (columns <= 0 || rows <= 0) {
+    std::cerr << "Invalid --board" << std::endl;
+    return 1;
+  }
+
+  const unsigned seed = parser.isSet(seedOption)
+    ? parser.value(seedOption).toUInt()
+    : static_cast<unsigned>(time(nullptr));
+
+  // Enabled before anything is loaded, so that the trace shows whether
+  // startup goes into composition or imaging.
+  const QString profilePath = parser.value(profileOption);
+  if (!profilePath.isEmpty()) {
+    pxr::TraceCollector::GetInstance().SetEnabled(true);
+  }
+
+  int result = 0;
+  if (parser.isSet(headlessOption)) {
+    HeadlessOptions options;
+    options.columns = columns;
+    options.rows = rows;
+    options.seed = seed;
+    options.playback = parser.isSet(playbackOption);
+    options.scriptPath = parser.value(scriptOption);
+    const QStringList size = parser.value(sizeOption).split('x');
+    if (size.size() == 2) {
+      options.size = QSize(size[0].toInt(), size[1].toInt());
+    }
+    if (options.size.isEmpty()) {
+      std::cerr << "Invalid --size" << std::endl;
+      return 1;
+    }
+    result = RunHeadless(options);
+  }
+  else {
+    View view;
+    view.setBoardSize(columns, rows);
+    view.setSeed(seed);
+    view.setPlayback(parser.isSet(playbackOption));
+    view.show();
+    result = app.exec();
+  }
+
+  if (!profilePath.isEmpty()) {
+    pxr::TraceCollector::GetInstance().SetEnabled(false);
+    std::ofstream trace(profilePath.toStdString());
+    pxr::TraceReporter::GetGlobalReporter()->ReportChromeTracing(trace);
+    if (!trace) {
+      std::cerr << "Failed to write " << qPrintable(profilePath) << std::endl;
+    }
+  }
+
+  return result;
 }
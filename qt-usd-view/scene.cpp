@@ -1,22 +1,166 @@
 #include "scene.h"
 
+#include <pxr/base/gf/rotation.h>
+#include <pxr/base/trace/trace.h>
+#include <pxr/usd/sdf/attributeSpec.h>
+#include <pxr/usd/sdf/changeBlock.h>
+#include <pxr/usd/sdf/primSpec.h>
+#include <pxr/usd/sdf/schema.h>
 #include <pxr/usd/usd/primRange.h>
-#include <pxr/usd/usd/references.h>
+#include <pxr/usd/usdGeom/bboxCache.h>
 #include <pxr/usd/usdGeom/camera.h>
-#include <pxr/usd/usdGeom/xformCommonAPI.h>
+#include <pxr/usd/usdGeom/mesh.h>
+#include <pxr/usd/usdGeom/tokens.h>
 #include "pxr/imaging/glf/simpleLightingContext.h"
 
+#include <algorithm>
+#include <chrono>
+#include <cmath>
 #include <iostream>
+#include <string>
 
 PXR_NAMESPACE_USING_DIRECTIVE
 
-Scene::Scene()
+static SdfPath SwitchPath(const SdfPath& board, int i, int j)
+{
+  return board.AppendChild(TfToken("xf" + std::to_string(i) + "x" + std::to_string(j)));
+}
+
+static GfVec3d SwitchTranslation(int i, int j)
+{
+  return GfVec3d(105.0 * i, 0.0, -105.0 * j);
+}
+
+// The board meshes are modelled for 4x4 switches, stretch them to fit.
+static void FitBoard(const UsdPrim& board, int columns, int rows)
+{
+  if (columns == 4 && rows == 4) {
+    return;
+  }
+
+  const float scaleX = columns / 4.0f;
+  const float scaleZ = rows / 4.0f;
+  auto fit = [&](VtVec3fArray& points, const GfVec3f& corner) {
+    for (GfVec3f& p : points) {
+      p[0] = corner[0] + (p[0] - corner[0]) * scaleX;
+      p[2] = corner[2] + (p[2] - corner[2]) * scaleZ;
+    }
+  };
+
+  for (const auto& prim : UsdPrimRange(board)) {
+    UsdGeomMesh mesh(prim);
+    VtVec3fArray extent;
+    VtVec3fArray points;
+    if (!prim.IsA<UsdGeomMesh>() || !mesh.GetExtentAttr().Get(&extent) || extent.size() != 2 || !mesh.GetPointsAttr().Get(&points)) {
+      continue;
+    }
+    // The first switch sits at the origin, the board grows along +x and -z.
+    const GfVec3f corner(extent[0][0], 0.0f, extent[1][2]);
+    fit(points, corner);
+    fit(extent, corner);
+    mesh.GetPointsAttr().Set(points);
+    mesh.GetExtentAttr().Set(extent);
+  }
+}
+
+// The camera is set up for 4x4 switches, move it back to see the whole board.
+static void FitCamera(GfCamera& camera, int columns, int rows)
+{
+  const double scale = std::max(columns, rows) / 4.0;
+  const GfVec3d oldCenter = (SwitchTranslation(0, 0) + SwitchTranslation(3, 3)) / 2.0;
+  const GfVec3d newCenter = (SwitchTranslation(0, 0) + SwitchTranslation(columns - 1, rows - 1)) / 2.0;
+
+  GfMatrix4d transform = camera.GetTransform();
+  transform.SetTranslateOnly(newCenter + (transform.ExtractTranslation() - oldCenter) * scale);
+  camera.SetTransform(transform);
+
+  const GfRange1f range = camera.GetClippingRange();
+  camera.SetClippingRange(GfRange1f(range.GetMin(), range.GetMax() * scale));
+}
+
+// Replaces the time samples of the attribute spec at path with a linear
+// ramp, which USD interpolates between the two samples. The spec has to
+// exist, only its values may change inside a change block.
+template <typename T>
+static void AuthorRamp(const SdfLayerHandle& layer, const SdfPath& path,
+                       double start, const T& from, double end, const T& to)
+{
+  layer->EraseField(path, SdfFieldKeys->TimeSamples);
+  layer->SetTimeSample(path, start, from);
+  if (end > start) {
+    layer->SetTimeSample(path, end, to);
+  }
+}
+
+// Authors every switch directly as Sdf specs. Going through UsdPrim and
+// UsdAttribute costs a stage recomposition per call, which dominates startup
+// for large boards; with a change block the stage recomposes once.
+static void AuthorSwitches(const SdfLayerHandle& layer, const SdfPath& board,
+                           const std::string& switchLayer, int columns, int rows,
+                           const std::vector<int>& turns)
+{
+  static const TfToken xformOpOrder[] = {
+    TfToken("xformOp:translate"), TfToken("xformOp:rotateXYZ"), TfToken("xformOp:scale")
+  };
+  const VtTokenArray opOrder(std::begin(xformOpOrder), std::end(xformOpOrder));
+
+  SdfChangeBlock changes;
+
+  SdfPrimSpecHandle boardSpec = SdfCreatePrimInLayer(layer, board);
+  for (int i = 0; i < columns; ++i) {
+    for (int j = 0; j < rows; ++j) {
+      auto xfSpec = SdfPrimSpec::New(boardSpec, SwitchPath(board, i, j).GetName(), SdfSpecifierDef, "Xform");
+
+      // Static USD produces warning that the visibility attribute doesn't
+      // exist.
+      SdfAttributeSpec::New(xfSpec, UsdGeomTokens->visibility.GetString(), SdfValueTypeNames->Token);
+
+      SdfAttributeSpec::New(xfSpec, xformOpOrder[0].GetString(), SdfValueTypeNames->Double3)
+        ->SetDefaultValue(VtValue(SwitchTranslation(i, j)));
+      SdfAttributeSpec::New(xfSpec, xformOpOrder[1].GetString(), SdfValueTypeNames->Float3)
+        ->SetDefaultValue(VtValue(GfVec3f(0.0f)));
+      SdfAttributeSpec::New(xfSpec, xformOpOrder[2].GetString(), SdfValueTypeNames->Float3)
+        ->SetDefaultValue(VtValue(GfVec3f(1.0f)));
+      SdfAttributeSpec::New(xfSpec, UsdGeomTokens->xformOpOrder.GetString(), SdfValueTypeNames->TokenArray,
+                            SdfVariabilityUniform)
+        ->SetDefaultValue(VtValue(opOrder));
+
+      // Set attributes
+      // Number of turns
+      SdfAttributeSpec::New(xfSpec, "turns", SdfValueTypeNames->Int, SdfVariabilityVarying, true)
+        ->SetDefaultValue(VtValue(turns[static_cast<size_t>(i) * rows + j]));
+
+      // Index
+      SdfAttributeSpec::New(xfSpec, "indexI", SdfValueTypeNames->Int, SdfVariabilityVarying, true)
+        ->SetDefaultValue(VtValue(i));
+      SdfAttributeSpec::New(xfSpec, "indexJ", SdfValueTypeNames->Int, SdfVariabilityVarying, true)
+        ->SetDefaultValue(VtValue(j));
+
+      // Add an object. Every switch shares one prototype through native
+      // instancing instead of being composed and imaged separately.
+      auto instSpec = SdfPrimSpec::New(xfSpec, "switch", SdfSpecifierDef);
+      instSpec->GetReferenceList().Prepend(SdfReference(switchLayer, SdfPath("/switch1")));
+      instSpec->SetInstanceable(true);
+    }
+  }
+}
+
+Scene::Scene(int columns, int rows, unsigned seed)
   : _width(0)
   , _height(0)
   , _won(false)
 {
-  _stage = UsdStage::Open("board.usda");
-  UsdStageRefPtr switchStage = UsdStage::Open("switch.usda");
+  TRACE_FUNCTION();
+
+  UsdStageRefPtr switchStage;
+  {
+    TRACE_SCOPE("Open board.usda");
+    _stage = UsdStage::Open("board.usda");
+  }
+  {
+    TRACE_SCOPE("Open switch.usda");
+    switchStage = UsdStage::Open("switch.usda");
+  }
   
   _board = _stage->GetPrimAtPath(SdfPath("/board1"));
   auto cameraPrim = _stage->GetPrimAtPath(SdfPath("/camera1"));
@@ -37,50 +181,81 @@ Scene::Scene()
       imageable.CreateVisibilityAttr();
   }
   
-  srand(time(nullptr));
-  
-  char name[32];
-  for (int i = 0; i < 4; ++i) {
-    for (int j = 0; j < 4; ++j) {
-      sprintf(name, "/board1/xf%ix%i", i, j);
-      auto xfPrim = _stage->DefinePrim(SdfPath(name), TfToken("Xform"));
-  
-      // Static USD produces warning that the visibility attribute doesn't
-      // exist.
-      UsdGeomImageable imageable(xfPrim);
-      imageable.CreateVisibilityAttr();
-  
-      UsdGeomXformCommonAPI(xfPrim).SetTranslate(
-              GfVec3f(105.0f * i, 0.0f, -105.0f * j));
-  
-      // Set attributes
-      // Number of turns
-      auto turnsAttr = xfPrim.CreateAttribute(
-              TfToken("turns"),
-              SdfValueTypeNames->Int,
-              true);
-      turnsAttr.Set(rand() % 2);
-  
-      // Index
-      auto indexIAttr = xfPrim.CreateAttribute(
-              TfToken("indexI"),
-              SdfValueTypeNames->Int,
-              true);
-      indexIAttr.Set(i);
-      auto indexJAttr = xfPrim.CreateAttribute(
-              TfToken("indexJ"),
-              SdfValueTypeNames->Int,
-              true);
-      indexJAttr.Set(j);
-  
-      // Add an object
-      sprintf(name, "%s/switch", name);
-      auto instPrim = _stage->DefinePrim(SdfPath(name));
-      instPrim.GetReferences().AddReference(
-              switchStage->GetRootLayer()->GetIdentifier(),
-              SdfPath("/switch1"));
+  srand(seed);
+
+  const auto start = std::chrono::steady_clock::now();
+
+  _turns.resize(static_cast<size_t>(columns) * rows);
+  for (int& turns : _turns) {
+    turns = rand() % 2;
+  }
+
+  FitBoard(_board, columns, rows);
+  FitCamera(_camera, columns, rows);
+  {
+    // The stage composes the new prims and references when the outer change
+    // block closes.
+    TRACE_SCOPE("Compose switches");
+    SdfChangeBlock changes;
+    TRACE_SCOPE("Author switches");
+    AuthorSwitches(_stage->GetEditTarget().GetLayer(), _board.GetPath(),
+                   switchStage->GetRootLayer()->GetIdentifier(), columns, rows, _turns);
+  }
+
+  const auto authored = std::chrono::steady_clock::now();
+
+  static const TfToken turnsToken("turns");
+  static const TfToken translateToken("xformOp:translate");
+  static const TfToken rotateToken("xformOp:rotateXYZ");
+  static const TfToken scaleToken("xformOp:scale");
+
+  const size_t count = _turns.size();
+  _switchIndices.reserve(count);
+  _switchPaths.reserve(count);
+  _turnsAttrs.reserve(count);
+  _translateOps.reserve(count);
+  _rotateOps.reserve(count);
+  _scaleOps.reserve(count);
+  _indexI.reserve(count);
+  _indexJ.reserve(count);
+  _translations.reserve(count);
+  _rotations.assign(count, 0.0f);
+  _scales.assign(count, 1.0f);
+  _rotationTargets.assign(count, 0.0f);
+  _scaleTargets.assign(count, 1.0f);
+  _heightTargets.assign(count, 0.0);
+
+  {
+    TRACE_SCOPE("Resolve switches");
+    for (int i = 0; i < columns; ++i) {
+      for (int j = 0; j < rows; ++j) {
+        const auto xfPrim = _stage->GetPrimAtPath(SwitchPath(_board.GetPath(), i, j));
+        _switchIndices[xfPrim.GetPath()] = static_cast<int>(_turnsAttrs.size());
+        _switchPaths.push_back(xfPrim.GetPath());
+        _turnsAttrs.push_back(xfPrim.GetAttribute(turnsToken));
+        _translateOps.emplace_back(xfPrim.GetAttribute(translateToken));
+        _rotateOps.emplace_back(xfPrim.GetAttribute(rotateToken));
+        _scaleOps.emplace_back(xfPrim.GetAttribute(scaleToken));
+        _indexI.push_back(i);
+        _indexJ.push_back(j);
+        _translations.push_back(SwitchTranslation(i, j));
+      }
     }
   }
+
+  if (count > 0) {
+    TRACE_SCOPE("Compute switch bounds");
+    UsdGeomBBoxCache bboxCache(UsdTimeCode::Default(), { UsdGeomTokens->default_, UsdGeomTokens->render });
+    _switchBound = bboxCache.ComputeUntransformedBound(_stage->GetPrimAtPath(_switchPaths[0])).ComputeAlignedRange();
+    _boardTransform = bboxCache.ComputeLocalToWorldTransform(_board);
+  }
+
+  const auto resolved = std::chrono::steady_clock::now();
+  using Milliseconds = std::chrono::duration<double, std::milli>;
+  std::cout << "board " << columns << "x" << rows << ": authored in "
+            << Milliseconds(authored - start).count() << " ms, resolved in "
+            << Milliseconds(resolved - authored).count() << " ms" << std::endl;
+  _created = start;
   
   GLint major = 0;
   GLint minor = 0;
@@ -97,66 +272,137 @@ Scene::Scene()
   _params.enableLighting = true;
 }
 
-void Scene::prepare(float seconds)
+void Scene::setPlayback(bool playback)
 {
-  bool rotated = false;
-  
-  for (const auto& prim : _board.GetChildren()) {
-    auto turnsAttr = prim.GetAttribute(TfToken("turns"));
-    if (!turnsAttr.IsValid()) {
-        continue;
+  _playback = playback;
+  if (!_playback) {
+    return;
+  }
+
+  // Keeps the animation curves out of the board layer.
+  const SdfLayerHandle sessionLayer = _stage->GetSessionLayer();
+  _stage->SetEditTarget(sessionLayer);
+
+  // prepare() only sets values inside its change block, so the overs and
+  // attribute specs the ramps go to are created here, once.
+  for (size_t k = 0; k < _switchPaths.size(); ++k) {
+    const SdfPrimSpecHandle primSpec = SdfCreatePrimInLayer(sessionLayer, _switchPaths[k]);
+    for (const UsdAttribute& attr : { _translateOps[k].GetAttr(), _rotateOps[k].GetAttr(), _scaleOps[k].GetAttr() }) {
+      if (!sessionLayer->GetAttributeAtPath(attr.GetPath())) {
+        SdfAttributeSpec::New(primSpec, attr.GetName().GetString(), attr.GetTypeName());
+      }
     }
+  }
+}
 
-    UsdGeomXformCommonAPI xf(prim);
+bool Scene::prepare(float seconds)
+{
+  TRACE_FUNCTION();
 
-    GfVec3d translation;
-    GfVec3f rotation;
-    GfVec3f scale;
-    GfVec3f pivot;
-    UsdGeomXformCommonAPI::RotationOrder rotOrder;
+  bool rotated = false;
+  bool changed = false;
+  bool animating = false;
 
-    xf.GetXformVectors(&translation, &rotation, &scale, &pivot, &rotOrder, UsdTimeCode::Default());
+  // In playback mode the switches follow time samples, and a frame only
+  // moves the time forward. The arrays below still track the values at the
+  // current time for picking and to tell when the animation ends.
+  const double previous = _time;
+  if (_playback) {
+    _time += seconds;
+    _params.frame = UsdTimeCode(_time);
+  }
 
-    int turns;
-    turnsAttr.Get(&turns);
+  // Only values that changed are authored, all in one batch, so that Hydra
+  // gets a single round of change notices per frame.
+  const SdfLayerHandle sessionLayer = _stage->GetSessionLayer();
+  SdfChangeBlock changes;
 
-    float target = std::min(90.0f * turns, rotation[1] + 300.0f * seconds);
-    if (target > rotation[1]) {
-      rotation[1] = target;
-      xf.SetRotate(rotation);
-      rotated = true;
+  for (size_t k = 0; k < _turns.size(); ++k) {
+    const float turned = 90.0f * _turns[k];
+    const float targetScale = static_cast<int>(k) == _hovered ? 1.1f : 1.0f;
+    const double targetHeight = _won > 1 ? -200.0 : 0.0;
+
+    // Every motion is linear, so a ramp from the previous frame to where the
+    // target is reached covers it until the target changes again.
+    if (_playback) {
+      if (turned != _rotationTargets[k]) {
+        _rotationTargets[k] = turned;
+        AuthorRamp(sessionLayer, _rotateOps[k].GetAttr().GetPath(),
+                   previous, GfVec3f(0.0f, _rotations[k], 0.0f),
+                   previous + (turned - _rotations[k]) / 300.0, GfVec3f(0.0f, turned, 0.0f));
+      }
+      if (targetScale != _scaleTargets[k]) {
+        _scaleTargets[k] = targetScale;
+        AuthorRamp(sessionLayer, _scaleOps[k].GetAttr().GetPath(),
+                   previous, GfVec3f(_scales[k]),
+                   previous + std::abs(targetScale - _scales[k]), GfVec3f(targetScale));
+      }
+      if (targetHeight != _heightTargets[k]) {
+        _heightTargets[k] = targetHeight;
+        AuthorRamp(sessionLayer, _translateOps[k].GetAttr().GetPath(),
+                   previous, _translations[k],
+                   previous + (_translations[k][1] - targetHeight) / 100.0,
+                   GfVec3d(_translations[k][0], targetHeight, _translations[k][2]));
+      }
     }
 
-    if (_current.HasPrefix(prim.GetPath())) {
-      float s = std::min(scale[0] + seconds, 1.1f);
-      if (scale[0] < s) {
-        xf.SetScale(GfVec3f(s, s, s));
+    const float rotation = std::min(turned, _rotations[k] + 300.0f * seconds);
+    if (rotation > _rotations[k]) {
+      _rotations[k] = rotation;
+      if (!_playback) {
+        _rotateOps[k].Set(GfVec3f(0.0f, rotation, 0.0f));
       }
+      rotated = true;
+      changed = true;
     }
-    else {
-      float s = std::max(scale[0] - seconds, 1.0f);
-      if (scale[0] > s) {
-        xf.SetScale(GfVec3f(s, s, s));
+    animating |= rotation < turned;
+
+    const float scale = targetScale > _scales[k]
+      ? std::min(_scales[k] + seconds, targetScale)
+      : std::max(_scales[k] - seconds, targetScale);
+    if (scale != _scales[k]) {
+      _scales[k] = scale;
+      if (!_playback) {
+        _scaleOps[k].Set(GfVec3f(scale));
       }
+      changed = true;
     }
+    animating |= scale != targetScale;
 
     if (_won > 1)
     {
-      double t = std::max(translation[1] - 100.0 * seconds, -200.0);
-      if (translation[1] > t) {
-        translation[1] = t;
-        xf.SetTranslate(translation);
+      const double height = std::max(_translations[k][1] - 100.0 * seconds, targetHeight);
+      if (height < _translations[k][1]) {
+        _translations[k][1] = height;
+        if (!_playback) {
+          _translateOps[k].Set(_translations[k]);
+        }
+        changed = true;
       }
+      animating |= height > targetHeight;
     }
   }
 
+  if (changed) {
+    ++_version;
+  }
+
   if (_won && !rotated) {
+    // The switches start sinking on the next frame.
+    animating |= _won == 1;
     _won = 2;
   }
+
+  return animating;
 }
 
 void Scene::draw(int width, int height)
 {
+  TRACE_FUNCTION();
+
+  if (width != _width || height != _height) {
+    ++_version;
+  }
   _width = width;
   _height = height;
   
@@ -175,8 +421,22 @@ void Scene::draw(int width, int height)
   _renderer.SetLightingStateFromOpenGL();
   _renderer.SetCameraState(viewMat, projMat);
   
-  // USD render.
-  _renderer.Render(_board, _params);
+  // USD render. Hydra populates its render index on the first frame.
+  if (_drawn) {
+    TRACE_SCOPE("Render");
+    _renderer.Render(_board, _params);
+  }
+  else {
+    TRACE_SCOPE("First render");
+    _renderer.Render(_board, _params);
+  }
+
+  if (!_drawn) {
+    _drawn = true;
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    std::cout << "first frame after " << Milliseconds(std::chrono::steady_clock::now() - _created).count()
+              << " ms" << std::endl;
+  }
   
   // Clear OpenGL errors. Because UsdImagingGL::TestIntersection prints them.
   while (glGetError() != GL_NO_ERROR) {
@@ -186,74 +446,135 @@ void Scene::draw(int width, int height)
 
 void Scene::click()
 {
-  if (_current.IsEmpty()) {
-      return;
-  }
-  
-  auto clickedPrim = _stage->GetPrimAtPath(_current);
-  while (clickedPrim.IsValid() && clickedPrim.GetTypeName() != "Xform") {
-    clickedPrim = clickedPrim.GetParent();
-  }
-  
-  if (!clickedPrim.IsValid()) {
+  TRACE_FUNCTION();
+
+  const int clicked = _hovered;
+  if (clicked < 0) {
       return;
   }
   
-  // Get index
-  int clickedI;
-  int clickedJ;
-  auto indexIAttr = clickedPrim.GetAttribute(TfToken("indexI"));
-  auto indexJAttr = clickedPrim.GetAttribute(TfToken("indexJ"));
-  indexIAttr.Get(&clickedI);
-  indexJAttr.Get(&clickedJ);
-  
   _won = 1;
   
   // Turn the switches of the same row and column
-  for (const auto& prim : _board.GetChildren()) {
-    auto turnsAttr = prim.GetAttribute(TfToken("turns"));
-    if (!turnsAttr.IsValid()) {
-      continue;
+  SdfChangeBlock changes;
+  for (size_t k = 0; k < _turns.size(); ++k) {
+    if (_indexI[k] == _indexI[clicked] || _indexJ[k] == _indexJ[clicked]) {
+      _turnsAttrs[k].Set(++_turns[k]);
     }
   
-    indexIAttr = prim.GetAttribute(TfToken("indexI"));
-    indexJAttr = prim.GetAttribute(TfToken("indexJ"));
-    int i;
-    int j;
-    indexIAttr.Get(&i);
-    indexJAttr.Get(&j);
-  
-    int turns;
-    turnsAttr.Get(&turns);
-  
-    if (clickedI == i || clickedJ == j) {
-      turnsAttr.Set(++turns);
-    }
-  
-    _won = _won & (turns % 2);
+    _won = _won & (_turns[k] % 2);
   }
+  ++_version;
 }
 
-void Scene::cursor(float x, float y)
+bool Scene::cursor(float x, float y)
 {
-  GfVec2d size(1.0 / _width, 1.0 / _height);
-  
-  // Compute pick frustum.
+  TRACE_FUNCTION();
+
+  if (_width <= 0 || _height <= 0) {
+    return false;
+  }
+
+  // TestIntersection renders the scene again, but a pixel keeps showing the
+  // same prim as long as nothing moved.
+  if (_pickVersion != _version || _picks.size() > 65536) {
+    _picks.clear();
+    _pickVersion = _version;
+  }
+
+  const std::int64_t pixel = static_cast<std::int64_t>(y * _height) * _width + static_cast<std::int64_t>(x * _width);
+  auto pick = _picks.find(pixel);
   auto cameraFrustum = _camera.GetFrustum();
-  auto frustum = cameraFrustum.ComputeNarrowedFrustum(GfVec2d(2.0 * x - 1.0, 2.0 * (1.0 - y) - 1.0), size);
-  
-  GfVec3d outHitPoint;
-  GfVec3d outHitNormal;
-  SdfPath outHitPrimPath;
-  
-  if (_renderer.TestIntersection(frustum.ComputeViewMatrix(), frustum.ComputeProjectionMatrix(),
-        _board, _params, &outHitPoint, &outHitNormal, &outHitPrimPath)) {
-    if (outHitPrimPath != _current) {
-      _current = outHitPrimPath;
+  const GfVec2d point(2.0 * x - 1.0, 2.0 * (1.0 - y) - 1.0);
+
+  // The switches are boxes on a grid, a ray cast finds them in microseconds.
+  // Only misses, e.g. on the board itself, need the engine to render a pick.
+  if (pick == _picks.end()) {
+    const int hit = intersectSwitches(cameraFrustum.ComputeRay(point));
+    if (hit >= 0) {
+      pick = _picks.emplace(pixel, _switchPaths[hit]).first;
+    }
+  }
+
+  if (pick == _picks.end()) {
+    GfVec2d size(1.0 / _width, 1.0 / _height);
+    
+    // Compute pick frustum.
+    auto frustum = cameraFrustum.ComputeNarrowedFrustum(point, size);
+    
+    GfVec3d outHitPoint;
+    GfVec3d outHitNormal;
+    SdfPath outHitPrimPath;
+    
+    TRACE_SCOPE("TestIntersection");
+    if (!_renderer.TestIntersection(frustum.ComputeViewMatrix(), frustum.ComputeProjectionMatrix(),
+          _board, _params, &outHitPoint, &outHitNormal, &outHitPrimPath)) {
+      outHitPrimPath = SdfPath();
+    }
+    pick = _picks.emplace(pixel, outHitPrimPath).first;
+  }
+
+  if (pick->second != _current) {
+    _current = pick->second;
+    if (!_current.IsEmpty()) {
       std::cout << "hit " << _current.GetPrimPath().GetString() << std::endl;
     }
   }
-  else {
-    _current = SdfPath();
+
+  const int hovered = switchIndex(_current);
+  if (hovered == _hovered) {
+    return false;
   }
+  _hovered = hovered;
+  return true;
+}
+
+int Scene::switchIndex(const SdfPath& path) const
+{
+  for (SdfPath p = path; !p.IsEmpty() && !p.IsAbsoluteRootPath(); p = p.GetParentPath()) {
+    const auto it = _switchIndices.find(p);
+    if (it != _switchIndices.end()) {
+      return it->second;
+    }
+  }
+  return -1;
+}
+
+GfMatrix4d Scene::switchTransform(size_t index) const
+{
+  // Matches the translate, rotateXYZ, scale op order.
+  return GfMatrix4d().SetScale(_scales[index])
+    * GfMatrix4d().SetRotate(GfRotation(GfVec3d::YAxis(), _rotations[index]))
+    * GfMatrix4d().SetTranslate(_translations[index])
+    * _boardTransform;
+}
+
+int Scene::intersectSwitches(const GfRay& ray)
+{
+  // Sunken switches are hidden by the board, which is not in the hierarchy.
+  if (_switchBound.IsEmpty() || _won > 1) {
+    return -1;
+  }
+
+  // The boxes only move when the switches animate, refitting keeps the tree.
+  if (_switchHierarchy.isEmpty() || _hierarchyVersion != _version) {
+    _switchBounds.resize(_switchPaths.size());
+    for (size_t k = 0; k < _switchPaths.size(); ++k) {
+      _switchBounds[k] = GfBBox3d(_switchBound, switchTransform(k)).ComputeAlignedRange();
+    }
+    if (_switchHierarchy.isEmpty()) {
+      _switchHierarchy.build(_switchBounds);
+    }
+    else {
+      _switchHierarchy.refit(_switchBounds);
+    }
+    _hierarchyVersion = _version;
+  }
+
+  return _switchHierarchy.intersect(ray, [this, &ray](int index, double* distance) {
+    // Ray distances are preserved by affine transforms.
+    GfRay local(ray);
+    local.Transform(switchTransform(index).GetInverse());
+    return local.Intersect(_switchBound, distance);
+  });
 }
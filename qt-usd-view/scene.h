@@ -3,19 +3,40 @@
 
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usd/prim.h>
+#include <pxr/usd/usdGeom/xformOp.h>
 #include <pxr/usdImaging/usdImagingGL/engine.h>
 #include <pxr/base/gf/camera.h>
 
+#include "boundshierarchy.h"
+
+#include <chrono>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
 class Scene
 {
 public:
-  Scene();
-  void prepare(float seconds);
+  // The seed decides the initial turns of the switches.
+  Scene(int columns, int rows, unsigned seed);
+  // Animates through time samples in the session layer instead of authoring
+  // new values every frame. Call before the first prepare().
+  void setPlayback(bool playback);
+  // Returns whether anything is still animating.
+  bool prepare(float seconds);
   void draw(int width, int height);
   void click();
-  void cursor(float x, float y);
+  // Returns whether the hovered switch changed. Results are cached per
+  // pixel until the scene or the viewport changes.
+  bool cursor(float x, float y);
 
 private:
+  // Index of the switch that owns the prim at path, or -1.
+  int switchIndex(const pxr::SdfPath& path) const;
+  pxr::GfMatrix4d switchTransform(size_t index) const;
+  // Ray casts against the switch boxes, returns the switch index or -1.
+  int intersectSwitches(const pxr::GfRay& ray);
+
   pxr::UsdStageRefPtr _stage;
   pxr::SdfPathVector _excludePaths;
   pxr::UsdImagingGLEngine _renderer;
@@ -24,10 +45,47 @@ private:
   pxr::UsdPrim _board;
   pxr::GfCamera _camera;
   pxr::SdfPath _current;
+  int _hovered = -1;
+
+  // Bumped whenever what is under a pixel may have changed.
+  unsigned _version = 0;
+  unsigned _pickVersion = 0;
+  std::unordered_map<std::int64_t, pxr::SdfPath> _picks;
+
+  // Every switch has the same geometry, so one local box serves all of them.
+  pxr::GfRange3d _switchBound;
+  pxr::GfMatrix4d _boardTransform;
+  std::vector<pxr::GfRange3d> _switchBounds;
+  BoundsHierarchy _switchHierarchy;
+  unsigned _hierarchyVersion = 0;
+
+  // Switch state, resolved once and mirrored into USD only when it changes.
+  std::unordered_map<pxr::SdfPath, int, pxr::SdfPath::Hash> _switchIndices;
+  pxr::SdfPathVector _switchPaths;
+  std::vector<pxr::UsdAttribute> _turnsAttrs;
+  std::vector<pxr::UsdGeomXformOp> _translateOps;
+  std::vector<pxr::UsdGeomXformOp> _rotateOps;
+  std::vector<pxr::UsdGeomXformOp> _scaleOps;
+  std::vector<int> _indexI;
+  std::vector<int> _indexJ;
+  std::vector<int> _turns;
+  std::vector<pxr::GfVec3d> _translations;
+  std::vector<float> _rotations;
+  std::vector<float> _scales;
+
+  // Playback mode, the values the authored ramps end at.
+  bool _playback = false;
+  double _time = 1.0;
+  std::vector<float> _rotationTargets;
+  std::vector<float> _scaleTargets;
+  std::vector<double> _heightTargets;
 
   int _width;
   int _height;
   int _won;
+
+  std::chrono::steady_clock::time_point _created;
+  bool _drawn = false;
 };
 
 #endif
@@ -4,11 +4,16 @@
 
 #include <QMouseEvent>
 #include <QOpenGLFunctions>
+#include <QScreen>
 
 View::View(QWidget* parent)
   : QOpenGLWidget(parent)
+  , _scheduler(new AnimationScheduler(this))
 { 
   setMouseTracking(true);
+
+  _pickTimer.setSingleShot(true);
+  connect(&_pickTimer, &QTimer::timeout, this, &View::pickNow);
 }
 
 View::~View()
@@ -18,15 +23,31 @@ View::~View()
   }
 }
 
+void View::setBoardSize(int columns, int rows)
+{
+  _columns = columns;
+  _rows = rows;
+}
+
+void View::setSeed(unsigned seed)
+{
+  _seed = seed;
+}
+
+void View::setPlayback(bool playback)
+{
+  _playback = playback;
+}
+
 void View::initializeGL()
 {
   // Set up the rendering context, load shaders and other resources, etc.:
   QOpenGLFunctions* f = QOpenGLContext::currentContext()->functions();
   f->glClearColor(1.0f, 1.0f, 1.0f, 1.0f);
-  _elapsed.start();
 
   // init usd after we've been initialized 
-  _scene = new Scene;
+  _scene = new Scene(_columns, _rows, _seed);
+  _scene->setPlayback(_playback);
 }
 
 inline void View::paintGL()
@@ -35,19 +56,57 @@ inline void View::paintGL()
   glDepthFunc(GL_LESS);
   glEnable(GL_BLEND);
 
-  _scene->prepare(_elapsed.elapsed() / 100.0f);
-  _scene->draw(width(), height());
-  _elapsed.restart();
+  if (_pickPending) {
+    pick();
+    // Picking draws into its own framebuffer.
+    QOpenGLContext::currentContext()->functions()->glBindFramebuffer(GL_FRAMEBUFFER, defaultFramebufferObject());
+  }
 
-  update();    
+  const bool animating = _scene->prepare(_scheduler->beginFrame() / 100.0f);
+  _scene->draw(width(), height());
+  _scheduler->endFrame(animating);
 }
 
 void View::mouseMoveEvent(QMouseEvent* event)
 {
-  _scene->cursor(event->x() / static_cast<float>(width()), event->y() / static_cast<float>(height()));
+  // Picking costs a render pass. Mouse moves only record the position, and at
+  // most one pick per frame runs with the latest one: in paintGL while
+  // animating, otherwise from a timer running at the display refresh rate.
+  _cursor = event->pos();
+  _pickPending = true;
+  if (!_scheduler->isAnimating() && !_pickTimer.isActive()) {
+    _pickTimer.start(qRound(1000.0 / qMax(screen()->refreshRate(), 1.0)));
+  }
 }
 
-void View::mousePressEvent(QMouseEvent* /*event*/)
+void View::mousePressEvent(QMouseEvent* event)
 {
+  // Click whatever is under the cursor now, not at the last pick.
+  _cursor = event->pos();
+  _pickPending = true;
+  pickNow();
+
   _scene->click();
+  _scheduler->wake();
+}
+
+bool View::pick()
+{
+  _pickTimer.stop();
+  if (!_pickPending || !_scene) {
+    return false;
+  }
+
+  _pickPending = false;
+  return _scene->cursor(_cursor.x() / static_cast<float>(width()), _cursor.y() / static_cast<float>(height()));
+}
+
+void View::pickNow()
+{
+  makeCurrent();
+  const bool changed = pick();
+  doneCurrent();
+  if (changed) {
+    _scheduler->wake();
+  }
 }
@@ -1,8 +1,11 @@
 #ifndef VIEW_H
 #define VIEW_H
 
-#include <QElapsedTimer>
+#include "animationscheduler.h"
+
 #include <QOpenGLWidget>
+#include <QPoint>
+#include <QTimer>
 
 class Scene;
 
@@ -12,14 +15,31 @@ public:
     explicit View(QWidget* parent = nullptr);
     ~View();
 
+    // These take effect when the GL context is initialized.
+    void setBoardSize(int columns, int rows);
+    void setSeed(unsigned seed);
+    void setPlayback(bool playback);
+
 private:
     void initializeGL() override;
     void paintGL() override;
     void	mouseMoveEvent(QMouseEvent* event) override;
     void	mousePressEvent(QMouseEvent* event) override; 
 
+    // Runs the pending hover pick, with the context current. Returns whether
+    // the hovered switch changed.
+    bool pick();
+    void pickNow();
+
     Scene* _scene = nullptr;
-    QElapsedTimer _elapsed;
+    AnimationScheduler* _scheduler;
+    QTimer _pickTimer;
+    QPoint _cursor;
+    bool _pickPending = false;
+    int _columns = 4;
+    int _rows = 4;
+    unsigned _seed = 0;
+    bool _playback = false;
 };
 
 #endif